@@ -135,21 +135,42 @@ const  CANSIG_PARA  CanSig[CANSIG_N] = {
 * Note(s)     : This Table must be modified by the user to define all Messages needed for 
 *               the Application. The below defined Messages are only examples and might be
 *               modified or removed.
+*
+*               With CANMSG_LINK_EXT_EN, the signal links of all messages are placed in the link array
+*               CanMsgLink[] and each message refers to the slice with its own links.
 *********************************************************************************************************
 */
 
+#if (CANMSG_LINK_EXT_EN > 0)
+const  CANMSG_LINK  CanMsgLink[] =
+{
+                                                                /* ------------------ MESSAGE STATUS ------------------ */
+    { S_NODESTATUS,                                             /*      Signal ID                                       */
+      0 },                                                      /*      Byte Position                                   */
+    { S_CPULOAD,                                                /*      Signal ID                                       */
+      2 },                                                      /*      Byte Position                                   */
+                                                                /* ----------------- MESSAGE COMMAND ------------------ */
+    { S_NODESTATUS,                                             /*      Signal ID                                       */
+      0 }                                                       /*      Byte Position                                   */
+};
+#endif
+
 const  CANMSG_PARA  CanMsg[CANMSG_N] = 
 { 
                                                                 /* ------------------ MESSAGE STATUS ------------------ */
    { 0x123L,                                                    /*      CAN-Identifier                                  */  
      CANMSG_TX,                                                 /*      Message Type                                    */ 
      3,                                                         /*      DLC of Message                                  */ 
-     3,                                                         /*      No. of Links                                    */ 
+     2,                                                         /*      No. of Links                                    */ 
+#if (CANMSG_LINK_EXT_EN > 0)
+     &CanMsgLink[0]                                             /*      Links: CanMsgLink[0..1]                         */
+#else
       { { S_NODESTATUS,                                         /*      Signal ID                                       */ 
          0 },                                                   /*      Byte Position                                   */ 
         { S_CPULOAD,                                            /*      Signal ID                                       */ 
          2 }                                                    /*      Byte Position                                   */ 
       },
+#endif
    },
 
                                                                 /* ----------------- MESSAGE COMMAND ------------------ */
@@ -157,9 +178,13 @@ const  CANMSG_PARA  CanMsg[CANMSG_N] =
      CANMSG_RX,                                                 /*      Message Type                                    */ 
      1,                                                         /*      DLC of Message                                  */ 
      1,                                                         /*      No. of Links                                    */ 
+#if (CANMSG_LINK_EXT_EN > 0)
+     &CanMsgLink[2]                                             /*      Links: CanMsgLink[2]                            */
+#else
      { { S_NODESTATUS,                                          /*      Signal ID                                       */ 
          0 }                                                    /*      Byte Position                                   */ 
      }
+#endif
    }
 }; 
 
@@ -211,7 +236,17 @@ const CANBUS_PARA CanCfg = {
         IO_<Drv_Name>_CAN_RX_EXTENDED,                          /*      Rx Extended                                     */
         IO_<Drv_Name>_CAN_TX_READY,                             /*      Tx Ready                                        */
         IO_<Drv_Name>_CAN_GET_NODE_STATUS,                      /*      Get Node Status                                 */
-    }
+    },
+    NULL_PTR,                                                   /* RX QUEUE STORAGE (NULL_PTR: default storage)         */
+    0u,                                                         /* RX QUEUE SIZE                                        */
+    NULL_PTR,                                                   /* TX QUEUE STORAGE (NULL_PTR: default storage)         */
+    0u,                                                         /* TX QUEUE SIZE                                        */
+#if CANBUS_TX_PRIO_EN > 0
+    NULL_PTR,                                                   /* TX HEAP SEQUENCE STORAGE                             */
+#endif
+    NULL_PTR,                                                   /* DRIVER BURST READ (NULL_PTR: single frame Read)      */
+    NULL_PTR,                                                   /* DRIVER RX IRQ CONTROL (NULL_PTR: no Rx polling)      */
+    NULL_PTR,                                                   /* DRIVER TX READY (NULL_PTR: IoCtl CAN_TX_READY)       */
 };
 
 
@@ -79,13 +79,32 @@ extern "C" {
 												  
 #define  CANBUS_STAT_EN                         1u              /*   Enable Bus Statistics                              */
 
-#define  CANBUS_TX_QSIZE                 (2u * CANBUS_N)        /*   Transmit Queue Size in CAN Frames for each CAN Bus */
-#define  CANBUS_RX_QSIZE                 (2u * CANBUS_N)        /*   Receive Queue Size in CAN Frames for each CAN Bus  */
+#define  CANBUS_TX_QSIZE                        8u              /*   Default Transmit Queue Size (power of 2 or 0)      */
+#define  CANBUS_RX_QSIZE                        8u              /*   Default Receive Queue Size (power of 2 or 0)       */
+                                                                /*   .. 0: each bus provides storage in CANBUS_PARA     */
+#define  CANBUS_TX_PRIO_EN                      0u              /*   Transmit Queue ordered by Identifier Priority      */
+#define  CANBUS_TX_CONFIRM_EN                   0u              /*   Enable Transmit Confirmation (CanBusWriteAsync)    */
+                                                                /*   .. 1: one frame at a time in the device            */
+#define  CANBUS_TX_CONFIRM_N                    8u              /*   Unconfirmed Frames per Bus (power of 2)            */
 
 #define  CANBUS_HOOK_NS_EN                      1u              /*   Enable Node Status Handler Hook Function           */
 #define  CANBUS_HOOK_RX_EN                      1u              /*   Enable Rx Handler Hook Function                    */
 #define  CANBUS_RX_READ_ALWAYS_EN               1u              /*   If enabled the Rx Handler executes a read even..   */
                                                                 /*   .. when frames can't be allocated                  */
+#define  CANBUS_RX_DEFER_EN                     0u              /*   Rx Handler only stages frames for CanBusRxService  */
+#define  CANBUS_RX_STAGE_SIZE                  16u              /*   Rx Staging Ring Size per Bus (power of 2)          */
+#define  CANBUS_RX_POLICY_EN                    0u              /*   Enable Rx Overflow Policies (drop-oldest, evict)   */
+#define  CANBUS_RX_COALESCE_EN                  0u              /*   Enable Coalescing of Rx Signals (CanBusRxTimer)    */
+#define  CANBUS_RX_POLL_EN                      0u              /*   Enable Rx Polling at High Load (CanBusRxPoll)      */
+#define  CANBUS_RX_MSG_EN                       0u              /*   Enable Unpacking of Rx Frames into CAN Messages    */
+#define  CANBUS_FILTER_EN                       0u              /*   Enable Software Acceptance Filter in Rx Handler    */
+#define  CANBUS_FILTER_EXT_N                   16u              /*   Number of Extended Identifiers per Bus Filter      */
+#define  CANBUS_SUB_EN                          0u              /*   Enable Receive Subscribers with own Queues         */
+#define  CANBUS_SUB_N                           4u              /*   Number of Receive Subscribers (all busses)         */
+#define  CANBUS_WAIT_EN                         0u              /*   Enable CanBusWaitAny for Multiple Busses           */
+#define  CANBUS_GW_EN                           0u              /*   Enable Frame Routing between Busses (Gateway)      */
+#define  CANBUS_GW_N                            8u              /*   Number of Gateway Routes (all busses)              */
+#define  CANBUS_GW_QSIZE                        8u              /*   Gateway Transmit Queue Size per Bus (power of 2)   */
 
 
 /*
@@ -97,6 +116,12 @@ extern "C" {
 #define  CANMSG_EN                              1u              /* Enable CAN Message Support                           */
 #define  CANMSG_N                               2u              /*   Number of messages                                 */
 #define  CANMSG_ARG_CHK_EN                      1u              /*   Enable runtime argument checking                   */
+#define  CANMSG_HASH_EN                         0u              /*   Enable Identifier Hash Index for CanMsgOpen()      */
+#define  CANMSG_HASH_SIZE                       4u              /*   Hash Index Size (power of 2, > CANMSG_N)           */
+#define  CANMSG_PLAN_EN                         0u              /*   Enable Precompiled Pack/Unpack Plans               */
+#define  CANMSG_LINK_EXT_EN                     0u              /*   Signal Links in external Arrays of any Length      */
+#define  CANMSG_PLAN_N                         16u              /*   Plan Entries of all Messages (CANMSG_LINK_EXT_EN)  */
+#define  CANMSG_CHANGED_EN                      0u              /*   Enable Changed Message Bitmap                      */
 
 
 /*
@@ -122,6 +147,8 @@ extern "C" {
 */
 
 #define  CANFRM_ARG_CHK_EN                      1u              /* Enable runtime argument checking                     */
+#define  CANFRM_TIMESTAMP_EN                    0u              /* Receive Timestamp in CANFRM: 0=off, 1=CANOS time..   */
+                                                                /*   .. base, 2=hardware timestamp of the driver        */
 
 
 /*
@@ -180,6 +207,14 @@ enum {
                                                                 /* --------------------- CAN FRAME -------------------- */
 #if  ((CANFRM_ARG_CHK_EN < 0u) || (CANFRM_ARG_CHK_EN > 1u))
 #error "CANFRM_ARG_CHK_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  ((CANFRM_TIMESTAMP_EN < 0u) || (CANFRM_TIMESTAMP_EN > 2u))
+#error "CANFRM_TIMESTAMP_EN is invalid; check definition to be 0, 1 or 2!"
+#endif
+
+#if  ((CANFRM_TIMESTAMP_EN > 0u) && (CANBUS_RX_HANDLER_EN == 0u))
+#error "CANFRM_TIMESTAMP_EN is invalid; timestamps are captured in CanBusRxHandler!"
 #endif
 
                                                                 /* -------------------- CAN SIGNALS ------------------- */
@@ -226,6 +261,38 @@ enum {
 
 #if  ((CANMSG_ARG_CHK_EN < 0u) || (CANMSG_ARG_CHK_EN > 1u))
 #error "CANMSG_ARG_CHK_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  ((CANMSG_HASH_EN < 0u) || (CANMSG_HASH_EN > 1u))
+#error "CANMSG_HASH_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  CANMSG_HASH_EN > 0
+#if  ((CANMSG_HASH_SIZE <= CANMSG_N) || (CANMSG_HASH_SIZE > 32768u) || ((CANMSG_HASH_SIZE & (CANMSG_HASH_SIZE - 1u)) != 0u))
+#error "CANMSG_HASH_SIZE is invalid; check definition to be a power of 2 greater than CANMSG_N and up to 32768!"
+#endif
+#endif
+
+#if  ((CANMSG_PLAN_EN < 0u) || (CANMSG_PLAN_EN > 1u))
+#error "CANMSG_PLAN_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  ((CANMSG_LINK_EXT_EN < 0u) || (CANMSG_LINK_EXT_EN > 1u))
+#error "CANMSG_LINK_EXT_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  ((CANMSG_PLAN_EN > 0u) && (CANMSG_LINK_EXT_EN > 0u))
+#if  ((CANMSG_PLAN_N < 1u) || (CANMSG_PLAN_N > 32767u))
+#error "CANMSG_PLAN_N is invalid; check definition to be in range 1 ... 32767!"
+#endif
+#endif
+
+#if  ((CANMSG_CHANGED_EN < 0u) || (CANMSG_CHANGED_EN > 1u))
+#error "CANMSG_CHANGED_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  ((CANMSG_CHANGED_EN > 0u) && ((CANMSG_EN == 0u) || (CANSIG_EN == 0u)))
+#error "CANMSG_CHANGED_EN is invalid; the changed message bitmap needs CANMSG_EN and CANSIG_EN to be 1!"
 #endif
 
                                                                 /* ---------------------- CAN BUS --------------------- */
@@ -257,12 +324,78 @@ enum {
 #error "CANBUS_STAT_EN is invalid; check definition to be 0 or 1!"
 #endif
 
-#if   (CANBUS_RX_QSIZE < 1u)
-#error "CANBUS_RX_QSIZE is invalid; check definition to be greater than 0!"
+#if   (CANBUS_RX_QSIZE > 32768u) || ((CANBUS_RX_QSIZE & (CANBUS_RX_QSIZE - 1u)) != 0u)
+#error "CANBUS_RX_QSIZE is invalid; check definition to be 0 or a power of 2 in range 1 ... 32768!"
+#endif
+
+#if   (CANBUS_TX_QSIZE > 32768u) || ((CANBUS_TX_QSIZE & (CANBUS_TX_QSIZE - 1u)) != 0u)
+#error "CANBUS_TX_QSIZE is invalid; check definition to be 0 or a power of 2 in range 1 ... 32768!"
+#endif
+
+#if  ((CANBUS_TX_PRIO_EN < 0u) || (CANBUS_TX_PRIO_EN > 1u))
+#error "CANBUS_TX_PRIO_EN is invalid; check definition to be 0 or 1!"
 #endif
 
-#if   (CANBUS_TX_QSIZE < 1u)
-#error "CANBUS_TX_QSIZE is invalid; check definition to be greater than 0!"
+#if  ((CANBUS_TX_CONFIRM_EN < 0u) || (CANBUS_TX_CONFIRM_EN > 1u))
+#error "CANBUS_TX_CONFIRM_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  ((CANBUS_TX_CONFIRM_EN > 0u) && (CANBUS_TX_HANDLER_EN == 0u))
+#error "CANBUS_TX_CONFIRM_EN is invalid; confirmations need CANBUS_TX_HANDLER_EN to be 1!"
+#endif
+
+#if   (CANBUS_TX_CONFIRM_N < 1u) || (CANBUS_TX_CONFIRM_N > 128u) || ((CANBUS_TX_CONFIRM_N & (CANBUS_TX_CONFIRM_N - 1u)) != 0u)
+#error "CANBUS_TX_CONFIRM_N is invalid; check definition to be a power of 2 in range 1 ... 128!"
+#endif
+
+#if  ((CANBUS_FILTER_EN < 0u) || (CANBUS_FILTER_EN > 1u))
+#error "CANBUS_FILTER_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  CANBUS_FILTER_EN > 0
+#if  ((CANBUS_FILTER_EXT_N < 1u) || (CANBUS_FILTER_EXT_N > 65535u))
+#error "CANBUS_FILTER_EXT_N is invalid; check definition to be in range 1 ... 65535!"
+#endif
+#endif
+
+#if  ((CANBUS_SUB_EN < 0u) || (CANBUS_SUB_EN > 1u))
+#error "CANBUS_SUB_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  CANBUS_SUB_EN > 0
+#if  ((CANBUS_SUB_N < 1u) || (CANBUS_SUB_N > 32767u))
+#error "CANBUS_SUB_N is invalid; check definition to be in range 1 ... 32767!"
+#endif
+#endif
+
+#if  ((CANBUS_WAIT_EN < 0u) || (CANBUS_WAIT_EN > 1u))
+#error "CANBUS_WAIT_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  ((CANBUS_WAIT_EN > 0u) && (CANBUS_N > 32u))
+#error "CANBUS_N is invalid; check definition to be in range 1 ... 32 when CANBUS_WAIT_EN is 1!"
+#endif
+
+#if  ((CANBUS_GW_EN < 0u) || (CANBUS_GW_EN > 1u))
+#error "CANBUS_GW_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  CANBUS_GW_EN > 0
+#if  ((CANBUS_RX_HANDLER_EN == 0u) || (CANBUS_TX_HANDLER_EN == 0u))
+#error "CANBUS_GW_EN is invalid; gateway needs CANBUS_RX_HANDLER_EN and CANBUS_TX_HANDLER_EN to be 1!"
+#endif
+
+#if  ((CANBUS_GW_N < 1u) || (CANBUS_GW_N > 32767u))
+#error "CANBUS_GW_N is invalid; check definition to be in range 1 ... 32767!"
+#endif
+
+#if  ((CANBUS_GW_QSIZE < 1u) || (CANBUS_GW_QSIZE > 32768u) || ((CANBUS_GW_QSIZE & (CANBUS_GW_QSIZE - 1u)) != 0u))
+#error "CANBUS_GW_QSIZE is invalid; check definition to be a power of 2 in range 1 ... 32768!"
+#endif
+
+#if  (CANBUS_N > 32u)
+#error "CANBUS_N is invalid; check definition to be in range 1 ... 32 when CANBUS_GW_EN is 1!"
+#endif
 #endif
 
 #if  ((CANBUS_HOOK_RX_EN < 0u) || (CANBUS_HOOK_RX_EN > 1u))
@@ -277,6 +410,50 @@ enum {
 #error "CANBUS_RX_READ_ALWAYS_EN is invalid; check definition to be 0 or 1!"
 #endif
 
+#if  ((CANBUS_RX_DEFER_EN < 0u) || (CANBUS_RX_DEFER_EN > 1u))
+#error "CANBUS_RX_DEFER_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  ((CANBUS_RX_DEFER_EN > 0u) && (CANBUS_RX_HANDLER_EN == 0u))
+#error "CANBUS_RX_DEFER_EN is invalid; deferred processing needs CANBUS_RX_HANDLER_EN to be 1!"
+#endif
+
+#if   (CANBUS_RX_STAGE_SIZE < 2u) || (CANBUS_RX_STAGE_SIZE > 1024u) || ((CANBUS_RX_STAGE_SIZE & (CANBUS_RX_STAGE_SIZE - 1u)) != 0u)
+#error "CANBUS_RX_STAGE_SIZE is invalid; check definition to be a power of 2 in range 2 ... 1024!"
+#endif
+
+#if  ((CANBUS_RX_POLICY_EN < 0u) || (CANBUS_RX_POLICY_EN > 1u))
+#error "CANBUS_RX_POLICY_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  ((CANBUS_RX_POLICY_EN > 0u) && (CANBUS_RX_HANDLER_EN == 0u))
+#error "CANBUS_RX_POLICY_EN is invalid; overflow policies need CANBUS_RX_HANDLER_EN to be 1!"
+#endif
+
+#if  ((CANBUS_RX_COALESCE_EN < 0u) || (CANBUS_RX_COALESCE_EN > 1u))
+#error "CANBUS_RX_COALESCE_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  ((CANBUS_RX_COALESCE_EN > 0u) && (CANBUS_RX_HANDLER_EN == 0u))
+#error "CANBUS_RX_COALESCE_EN is invalid; coalescing needs CANBUS_RX_HANDLER_EN to be 1!"
+#endif
+
+#if  ((CANBUS_RX_POLL_EN < 0u) || (CANBUS_RX_POLL_EN > 1u))
+#error "CANBUS_RX_POLL_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  ((CANBUS_RX_POLL_EN > 0u) && (CANBUS_RX_HANDLER_EN == 0u))
+#error "CANBUS_RX_POLL_EN is invalid; polling needs CANBUS_RX_HANDLER_EN to be 1!"
+#endif
+
+#if  ((CANBUS_RX_MSG_EN < 0u) || (CANBUS_RX_MSG_EN > 1u))
+#error "CANBUS_RX_MSG_EN is invalid; check definition to be 0 or 1!"
+#endif
+
+#if  ((CANBUS_RX_MSG_EN > 0u) && ((CANBUS_RX_HANDLER_EN == 0u) || (CANMSG_EN == 0u)))
+#error "CANBUS_RX_MSG_EN is invalid; message unpacking needs CANBUS_RX_HANDLER_EN and CANMSG_EN to be 1!"
+#endif
+
 
 /*
 *********************************************************************************************************
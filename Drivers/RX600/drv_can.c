@@ -393,14 +393,17 @@ CPU_INT16S  RX600_CAN_Init (CPU_INT32U  para_id)
     DEF_BIT_SET(p_reg->TFCR, RX600_CAN_TFCR_TFE);               /* Enable Tx FIFO                                       */
 #endif
                                                                 /* --------------- ENABLE RX INTERRUPTS --------------- */
+    RX600_DevData[para_id].RxIntMsk = 0u;                       /* Remember Rx Interrupts for RX600_CAN_RxIrq()         */
     for (i = 0u; i < RX600_CAN_NBR_MBOX; i++) {                 /* Enable RX Mailbox Interrupts                         */
         if (p_mbox[i].tx_rx == CAN_RX) {                        /* Configure Mailboxes set for Reception, see Note (4). */
             DEF_BIT_SET(p_reg->MIER, RX600_CAN_MAILBOX_MIER_INT_EN(i));
+            DEF_BIT_SET(RX600_DevData[para_id].RxIntMsk, RX600_CAN_MAILBOX_MIER_INT_EN(i));
         }
     }
 
 #if (CAN_MAILBOX_MODE == FIFO_MAILBOX_MODE)
     DEF_BIT_SET(p_reg->MIER, RX600_CAN_MIER_RX_FIFO_INT_EN);    /* Enable Rx FIFO Interrupt                             */
+    DEF_BIT_SET(RX600_DevData[para_id].RxIntMsk, RX600_CAN_MIER_RX_FIFO_INT_EN);
     DEF_BIT_SET(p_reg->MIER, RX600_CAN_MIER_TX_FIFO_INT_EN);    /* Enable Tx FIFO Interrupt                             */
 #endif
                                                                 /* ----------------- ENABLE CAN MODULE ---------------- */
@@ -1084,6 +1087,161 @@ CPU_INT16S  RX600_CAN_Read (CPU_INT16S   para_id,
 }
 
 
+/*
+*********************************************************************************************************
+*                                           RX600_CAN_ReadN()
+*
+* Description : Read all received CAN Frames out of the Rx FIFO and the Rx Mailboxes into consecutive
+*               Buffer entries. Each entry gets one CAN Frame in its first bytes.
+*
+* Argument(s) : para_id     Parameter Identifier, returned by RX600_CAN_Open().
+*
+*               buf         Pointer to array of CAN Frames.
+*
+*               size        Length of a single array entry.
+*
+*               num         Number of array entries.
+*
+* Return(s)   : Number of read CAN Frames (0 if no Frame is pending), or -1 if an Error Occurred.
+*
+* Caller(s)   : CanCfg in can_cfg.c
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT16S  RX600_CAN_ReadN (CPU_INT16S   para_id,
+                             CPU_INT08U  *buf,
+                             CPU_INT16U   size,
+                             CPU_INT16U   num)
+{
+    CPU_INT16S  result;
+    CPU_INT16S  err;
+
+
+    result = 0;                                                 /* Initializing Variable(s)                             */
+
+    if (size < sizeof(RX600_CAN_FRM)) {                         /* Check if Size is Plausible                           */
+        RX600_DrvErr = RX600_CAN_ERR_NO_DATA;
+        return (-1);
+    }
+
+    while ((CPU_INT16U)result < num) {                          /* Read until Mailboxes are Empty or Buffer is Full     */
+        err = RX600_CAN_Read(para_id, buf, sizeof(RX600_CAN_FRM));
+        if (err < 0) {
+            if (RX600_DrvErr != RX600_CAN_ERR_NO_DATA) {        /* Report Error, if no Frame could be Read              */
+                if (result == 0) {
+                    result = -1;
+                }
+            }
+            break;
+        }
+        buf += size;                                            /* Next array entry                                     */
+        result++;
+    }
+
+    return (result);                                            /* Return Function Result                               */
+}
+
+
+/*
+*********************************************************************************************************
+*                                           RX600_CAN_RxIrq()
+*
+* Description : Disable or Enable the Rx FIFO and Rx Mailbox Interrupts of the CAN Device. While the
+*               Interrupts are disabled, the received Frames are read with RX600_CAN_ReadN().
+*
+* Argument(s) : para_id     Parameter Identifier, returned by RX600_CAN_Open().
+*
+*               enable      0 = Disable Rx Interrupts, 1 = Enable Rx Interrupts.
+*
+* Return(s)   : Error code:  0 = No Error
+*                           -1 = Error Occurred
+*
+* Caller(s)   : CanCfg in can_cfg.c
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT16S  RX600_CAN_RxIrq (CPU_INT16S   para_id,
+                             CPU_INT08U   enable)
+{
+    RX600_CAN_REG  *p_reg;
+    CPU_SR_ALLOC();
+
+
+    if ((para_id <  0) ||                                       /* Check if Parameter ID is out of Range                */
+        (para_id >= RX600_CAN_N_DEV)) {
+        RX600_DrvErr = RX600_CAN_ERR_BUS;
+        return (-1);
+    }
+
+    if (RX600_DevData[para_id].Use != DEF_YES) {                /* Check if CAN Device is Opened                        */
+        RX600_DrvErr = RX600_CAN_ERR_OPEN;
+        return (-1);
+    }
+
+    p_reg = RX600_DevData[para_id].RegPtr;                      /* Set Base Address for CAN Device(s)                   */
+
+    CPU_CRITICAL_ENTER();
+    if (enable != 0u) {                                         /* Set or Clear all Rx Interrupt Enable Bits            */
+        DEF_BIT_SET(p_reg->MIER, RX600_DevData[para_id].RxIntMsk);
+    } else {
+        DEF_BIT_CLR(p_reg->MIER, RX600_DevData[para_id].RxIntMsk);
+    }
+    CPU_CRITICAL_EXIT();
+
+    return (0);                                                 /* Return Function Result                               */
+}
+
+
+/*
+*********************************************************************************************************
+*                                           RX600_CAN_TxReady()
+*
+* Description : Check if the CAN Device is ready to accept a Frame for Transmission. This is the fast
+*               alternative to the IO_RX600_CAN_TX_READY Function Code of RX600_CAN_IoCtl().
+*
+* Argument(s) : para_id     Parameter Identifier, returned by RX600_CAN_Open().
+*
+* Return(s)   : Tx Status:   1 = Ready to Transmit
+*                            0 = Tx FIFO is Full
+*                           -1 = Error Occurred
+*
+* Caller(s)   : CanCfg in can_cfg.c
+*
+* Note(s)     : (1) See Note(1) of RX600_CAN_IoCtl().
+*********************************************************************************************************
+*/
+
+CPU_INT16S  RX600_CAN_TxReady (CPU_INT16S   para_id)
+{
+    RX600_CAN_REG  *p_reg;
+
+
+    if ((para_id <  0) ||                                       /* Check if Parameter ID is out of Range                */
+        (para_id >= RX600_CAN_N_DEV)) {
+        RX600_DrvErr = RX600_CAN_ERR_BUS;
+        return (-1);
+    }
+
+    p_reg = RX600_DevData[para_id].RegPtr;                      /* Set Base Address for CAN Device(s)                   */
+
+    if (DEF_BIT_IS_SET(p_reg->STR, RX600_CAN_STR_SDST) == DEF_YES) {
+        return (1);                                             /* Mailbox(es) w/ Data to send, OK to Transmit          */
+    }
+    if (RX600_DevData[para_id].InitCmpl == DEF_FALSE) {         /* Initialize New Tx Mbox Transfer. See Note(1)         */
+        return (1);
+    }
+    if (DEF_BIT_IS_SET(p_reg->STR, RX600_CAN_STR_TFST) == DEF_YES) {
+        return (1);                                             /* Tx FIFO is Not Full, OK to Transmit                  */
+    }
+
+    return (0);                                                 /* Tx FIFO is Full, No Data to Send                     */
+}
+
+
 /*
 *********************************************************************************************************
 *                                           RX600_CAN_Write()
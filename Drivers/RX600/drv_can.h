@@ -210,6 +210,7 @@ typedef  struct  rx600_can_data {
     RX600_CAN_REG  *RegPtr;                                     /* REGISTER  : Pointer to the CAN Base Address(s)       */
     CPU_BOOLEAN     InitCmpl;                                   /* INIT COMP : Completion Variable of TX MBoxes         */
     CPU_INT08U      AvailTxMBox;                                /* AVAILABLE : Tx MBox is Available for Config          */
+    CPU_INT32U      RxIntMsk;                                   /* RX IRQ    : MIER Bits of all Rx Interrupts           */
 } RX600_CAN_DATA;
 
 
@@ -258,6 +259,16 @@ CPU_INT16S  RX600_CAN_Read    (CPU_INT16S   para_id,
                                CPU_INT08U  *buf,
                                CPU_INT16U   size);
 
+CPU_INT16S  RX600_CAN_ReadN   (CPU_INT16S   para_id,
+                               CPU_INT08U  *buf,
+                               CPU_INT16U   size,
+                               CPU_INT16U   num);
+
+CPU_INT16S  RX600_CAN_RxIrq   (CPU_INT16S   para_id,
+                               CPU_INT08U   enable);
+
+CPU_INT16S  RX600_CAN_TxReady (CPU_INT16S   para_id);
+
 CPU_INT16S  RX600_CAN_Write   (CPU_INT16S   para_id,
                                CPU_INT08U  *buf,
                                CPU_INT16U   size);
@@ -510,6 +510,43 @@ CPU_INT16S SJA1000CANRead (CPU_INT16S paraId, CPU_INT08U *buffer, CPU_INT16U siz
     return(result);                                   /* Return function result                   */
 }
 
+/*------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      CAN BURST READ DATA
+* \ingroup  SJA1000_CAN
+*
+*           Read all received messages out of the receive FIFO into consecutive buffer entries.
+*           Each entry gets one CAN frame in its first bytes.
+*
+* \param    paraId            unused, but needed for common interface
+* \param    buffer            byte array for received data
+* \param    size              length of a single buffer entry
+* \param    num               number of buffer entries
+*
+* \return   errorcode         (number of read frames if ok, -1 if an error occured)
+*/
+/*------------------------------------------------------------------------------------------------*/
+CPU_INT16S SJA1000CANReadN (CPU_INT16S paraId, CPU_INT08U *buffer, CPU_INT16U size, CPU_INT16U num)
+{
+    CPU_INT16S      result = 0;                       /* Local: Result of function                */
+                                                      /*------------------------------------------*/
+#if SJA1000_CAN_ARG_CHK_CFG > 0
+
+    if (size < sizeof(SJA1000_CANFRM)) {              /* check that size is plausible             */
+        DrvError = SJA1000_CAN_NO_DATA_ERR;
+        return(-1);
+    }
+#endif
+    while ((CPU_INT16U)result < num) {                /* read until FIFO is empty or buffer full  */
+        if (SJA1000CANRead(paraId, buffer, sizeof(SJA1000_CANFRM)) < 0) {
+            break;
+        }
+        buffer += size;                               /* next buffer entry                        */
+        result++;
+    }
+    return(result);                                   /* Return function result                   */
+}
+
 /*------------------------------------------------------------------------------------------------*/
 /*!
 * \brief                      CAN WRITE DATA
@@ -363,6 +363,7 @@ CPU_INT16S SJA1000CANOpen    (CPU_INT16S devId,  CPU_INT32U devName, CPU_INT16U
 CPU_INT16S SJA1000CANClose   (CPU_INT16S paraId);
 CPU_INT16S SJA1000CANIoCtl   (CPU_INT16S paraId, CPU_INT16U func,    void* arg);
 CPU_INT16S SJA1000CANRead    (CPU_INT16S paraId, CPU_INT08U *buffer,  CPU_INT16U cnt);
+CPU_INT16S SJA1000CANReadN   (CPU_INT16S paraId, CPU_INT08U *buffer,  CPU_INT16U size, CPU_INT16U num);
 CPU_INT16S SJA1000CANWrite   (CPU_INT16S paraId, CPU_INT08U *buffer,  CPU_INT16U cnt);
 
 #if SJA1000_CAN_INTERRUPT_EN > 0
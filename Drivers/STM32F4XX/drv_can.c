@@ -139,6 +139,9 @@ CPU_INT16S STM32F4XXCANInit (CPU_INT32U arg)
     can->MCR = STM32F4XX_CAN_MCR_INRQ;                /* set init bit                             */
     while ((can->MSR & STM32F4XX_CAN_MSR_INAK) == 0) {/* wait for init mode                       */
     }
+#if STM32F4XX_CAN_TIMESTAMP_CFG > 0
+    can->MCR |= STM32F4XX_CAN_MCR_TTCM;               /* enable timestamp of received frames      */
+#endif
                                                       /*------------------------------------------*/
     dev->Baudrate        = STM32F4XX_DEF_BAUDRATE;    /* Initialize parameter struct of the       */
     dev->SamplePoint     = STM32F4XX_DEF_SP;          /* current device                           */
@@ -534,6 +537,53 @@ CPU_INT16S STM32F4XXCANIoCtl (CPU_INT16S paraId, CPU_INT16U func, void *argp)
     return (result);                                   /* Return function result                   */
 }
 
+/*------------------------------------------------------------------------------------------------*/
+/*!
+* \brief    CAN GET FRAME
+*
+* \ingroup  STM32F4XX_CAN
+*
+*           Copy the can frame out of the output mailbox of the given receive fifo. The output
+*           mailbox is not released.
+*
+* \param    can     pointer to can register
+* \param    fifo    receive fifo number (0 or 1)
+* \param    frm     pointer to CAN frame
+*/
+/*------------------------------------------------------------------------------------------------*/
+static void STM32F4XXCAN_GetFrame (STM32F4XX_CAN_t *can, CPU_INT32S fifo, STM32F4XX_CANFRM *frm)
+{
+    CPU_INT32U          Word;                         /* Local: A word for extended IO access     */
+                                                      /*------------------------------------------*/
+                                                      /* Get the Id                               */
+    Word = can->FIFOMailBox[fifo].RIR & 0x04;         /* get IDE bit                              */
+    if (Word == 0) {                                  /* is std id                                */
+        frm->Identifier  = can->FIFOMailBox[fifo].RIR >> 21;
+    } else {
+        frm->Identifier  = can->FIFOMailBox[fifo].RIR >> 3;
+        frm->Identifier |= STM32F4XX_FF_FRAME_BIT;    /* mark ext. ID                             */
+    }
+    if ((can->FIFOMailBox[fifo].RIR & 0x02) != 0) {   /* check remote frame                       */
+        frm->Identifier |= STM32F4XX_RTR_FRAME_BIT;   /* mark remote frame                        */
+    }
+                                                      /* Get the DLC                              */
+    frm->DLC = can->FIFOMailBox[fifo].RDTR & 0x0F;
+#if STM32F4XX_CAN_TIMESTAMP_CFG > 0
+                                                      /* Get the timestamp                        */
+    frm->Timestamp = can->FIFOMailBox[fifo].RDTR >> 16;
+#endif
+                                                      /* Get the data field                       */
+    frm->Data[0] = (CPU_INT08U)(can->FIFOMailBox[fifo].RDLR      );
+    frm->Data[1] = (CPU_INT08U)(can->FIFOMailBox[fifo].RDLR >>  8);
+    frm->Data[2] = (CPU_INT08U)(can->FIFOMailBox[fifo].RDLR >> 16);
+    frm->Data[3] = (CPU_INT08U)(can->FIFOMailBox[fifo].RDLR >> 24);
+
+    frm->Data[4] = (CPU_INT08U)(can->FIFOMailBox[fifo].RDHR      );
+    frm->Data[5] = (CPU_INT08U)(can->FIFOMailBox[fifo].RDHR >>  8);
+    frm->Data[6] = (CPU_INT08U)(can->FIFOMailBox[fifo].RDHR >> 16);
+    frm->Data[7] = (CPU_INT08U)(can->FIFOMailBox[fifo].RDHR >> 24);
+}
+
 /*------------------------------------------------------------------------------------------------*/
 /*!
 * \brief    CAN READ DATA
@@ -541,7 +591,8 @@ CPU_INT16S STM32F4XXCANIoCtl (CPU_INT16S paraId, CPU_INT16U func, void *argp)
 * \ingroup  STM32F4XX_CAN
 *
 *           Read a received can frame from a message buffer. The buffer must have space for only
-*           one can frame.
+*           one can frame. The fifo output mailbox is not released by this function; the receive
+*           interrupt releases it after the frame is read, if STM32F4XXCANReadN() is not used.
 *
 * \param    paraId  parameter identifier, returned by XXXCANOpen()
 * \param    buffer  pointer to CAN frame
@@ -556,7 +607,6 @@ CPU_INT16S STM32F4XXCANRead (CPU_INT16S paraId, CPU_INT08U *buffer, CPU_INT16U s
     STM32F4XX_CAN_t    *can;                          /* Local: Pointer to can register           */
     CPU_INT16S          result = -1;                  /* Local: return value                      */
     STM32F4XX_CANFRM   *frm;                          /* Local: Pointer to can frame              */
-    CPU_INT32U          Word;                         /* Local: A word for extended IO access     */
     CPU_INT32S          FIFONumber;                   /* Local: receive fifo                      */
     CPU_SR_ALLOC();                                   /* Allocate storage for CPU status reg.     */
                                                       /*------------------------------------------*/
@@ -593,37 +643,167 @@ CPU_INT16S STM32F4XXCANRead (CPU_INT16S paraId, CPU_INT08U *buffer, CPU_INT16U s
         FIFONumber = 1;
     }
     if (FIFONumber >= 0) {
-                                                      /* Get the Id                               */
-        Word = can->FIFOMailBox[FIFONumber].RIR & 0x04; /* get IDE bit                            */
-        if (Word == 0) {                              /* is std id                                */
-            frm->Identifier  = can->FIFOMailBox[FIFONumber].RIR >> 21;
+        STM32F4XXCAN_GetFrame(can, FIFONumber, frm);  /* get the can frame                        */
+        result   = size;
+    } else {
+        DrvError = STM32F4XX_CAN_NO_DATA_ERR;
+    }
+    CPU_CRITICAL_EXIT();
+                                                      /*------------------------------------------*/
+    return (result);                                  /* Return function result                   */
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*!
+* \brief    CAN BURST READ DATA
+*
+* \ingroup  STM32F4XX_CAN
+*
+*           Read all received can frames out of both receive fifos into consecutive buffer
+*           entries. Each entry gets one can frame in its first bytes. The output mailbox of each
+*           read frame is released by this function, so the receive interrupt must not release
+*           the output mailbox, when this function is used. The CAN bus layer then reads every
+*           frame of the device with this function (single or discarded frames with num = 1),
+*           so all frames are released.
+*
+* \param    paraId  parameter identifier, returned by XXXCANOpen()
+* \param    buffer  pointer to array of CAN frames
+* \param    size    length of a single array entry
+* \param    num     number of array entries
+*
+* \return   error code (number of read frames if OK, -1 if an error occurred)
+*/
+/*------------------------------------------------------------------------------------------------*/
+CPU_INT16S STM32F4XXCANReadN (CPU_INT16S paraId, CPU_INT08U *buffer, CPU_INT16U size, CPU_INT16U num)
+{
+    STM32F4XX_CAN_DATA *dev;                          /* Local: Pointer to can device             */
+    STM32F4XX_CAN_t    *can;                          /* Local: Pointer to can register           */
+    CPU_INT16S          result = -1;                  /* Local: return value                      */
+    CPU_SR_ALLOC();                                   /* Allocate storage for CPU status reg.     */
+                                                      /*------------------------------------------*/
+#if STM32F4XX_CAN_ARG_CHK_CFG > 0
+    if ((paraId >= STM32F4XX_CAN_N_DEV) || (paraId < 0)) { /* check that paraId is in range       */
+        DrvError = STM32F4XX_CAN_BUS_ERR;
+        return (result);
+    }
+    if (size < sizeof(STM32F4XX_CANFRM)) {            /* check that size is plausible             */
+        DrvError = STM32F4XX_CAN_NO_DATA_ERR;
+        return (result);
+    }
+    if (buffer == (void *)0) {                        /* invalid buffer pointer                   */
+        DrvError = STM32F4XX_CAN_ARG_ERR;
+        return (result);
+    }
+#endif
+    dev = &DevData[paraId];                           /* set pointer to can device                */
+#if STM32F4XX_CAN_ARG_CHK_CFG > 0
+    if (dev->Use != 1) {                              /* check, that can device is opened         */
+        DrvError = STM32F4XX_CAN_OPEN_ERR;
+        return (result);
+    }
+#endif
+    can = (STM32F4XX_CAN_t *)dev->Base;
+
+    result = 0;
+    CPU_CRITICAL_ENTER();
+    while ((CPU_INT16U)result < num) {                /* read until fifos are empty or buffer full*/
+        if ((can->RF0R & 0x03) >= 1) {                /* data is available in fifo 0              */
+            STM32F4XXCAN_GetFrame(can, 0, (STM32F4XX_CANFRM *)buffer);
+            can->RF0R = STM32F4XX_CAN_RF0R_RFOM0;     /* release fifo 0 output mailbox            */
+        } else if ((can->RF1R & 0x03) >= 1) {        /* data is available in fifo 1              */
+            STM32F4XXCAN_GetFrame(can, 1, (STM32F4XX_CANFRM *)buffer);
+            can->RF1R = STM32F4XX_CAN_RF1R_RFOM1;     /* release fifo 1 output mailbox            */
         } else {
-            frm->Identifier  = can->FIFOMailBox[FIFONumber].RIR >> 3;
-            frm->Identifier |= STM32F4XX_FF_FRAME_BIT;/* mark ext. ID                             */
-        }
-        if ((can->FIFOMailBox[FIFONumber].RIR & 0x02) != 0) { /* check remote frame               */
-            frm->Identifier |= STM32F4XX_RTR_FRAME_BIT;/* mark remote frame                       */
+            break;
         }
-                                                      /* Get the DLC                              */
-        frm->DLC = can->FIFOMailBox[FIFONumber].RDTR & 0x0F;
-                                                      /* Get the data field                       */
-        frm->Data[0] = (CPU_INT08U)(can->FIFOMailBox[FIFONumber].RDLR      );
-        frm->Data[1] = (CPU_INT08U)(can->FIFOMailBox[FIFONumber].RDLR >>  8);
-        frm->Data[2] = (CPU_INT08U)(can->FIFOMailBox[FIFONumber].RDLR >> 16);
-        frm->Data[3] = (CPU_INT08U)(can->FIFOMailBox[FIFONumber].RDLR >> 24);
+        buffer += size;                               /* next array entry                         */
+        result++;
+    }
+    CPU_CRITICAL_EXIT();
+                                                      /*------------------------------------------*/
+    return (result);                                  /* Return function result                   */
+}
 
-        frm->Data[4] = (CPU_INT08U)(can->FIFOMailBox[FIFONumber].RDHR      );
-        frm->Data[5] = (CPU_INT08U)(can->FIFOMailBox[FIFONumber].RDHR >>  8);
-        frm->Data[6] = (CPU_INT08U)(can->FIFOMailBox[FIFONumber].RDHR >> 16);
-        frm->Data[7] = (CPU_INT08U)(can->FIFOMailBox[FIFONumber].RDHR >> 24);
+/*------------------------------------------------------------------------------------------------*/
+/*!
+* \brief    CAN RECEIVE INTERRUPT CONTROL
+*
+* \ingroup  STM32F4XX_CAN
+*
+*           Disable or enable the message pending interrupts of both receive fifos. While the
+*           interrupts are disabled, the received frames are read with STM32F4XXCANReadN().
+*
+* \param    paraId  parameter identifier, returned by XXXCANOpen()
+* \param    enable  0 = disable receive interrupts, 1 = enable receive interrupts
+*
+* \return   error code (0 if OK, -1 if an error occurred)
+*/
+/*------------------------------------------------------------------------------------------------*/
+CPU_INT16S STM32F4XXCANRxIrq (CPU_INT16S paraId, CPU_INT08U enable)
+{
+    STM32F4XX_CAN_DATA *dev;                          /* Local: Pointer to can device             */
+    STM32F4XX_CAN_t    *can;                          /* Local: Pointer to can register           */
+    CPU_SR_ALLOC();                                   /* Allocate storage for CPU status reg.     */
+                                                      /*------------------------------------------*/
+#if STM32F4XX_CAN_ARG_CHK_CFG > 0
+    if ((paraId >= STM32F4XX_CAN_N_DEV) || (paraId < 0)) { /* check that paraId is in range       */
+        DrvError = STM32F4XX_CAN_BUS_ERR;
+        return (-1);
+    }
+#endif
+    dev = &DevData[paraId];                           /* set pointer to can device                */
+#if STM32F4XX_CAN_ARG_CHK_CFG > 0
+    if (dev->Use != 1) {                              /* check, that can device is opened         */
+        DrvError = STM32F4XX_CAN_OPEN_ERR;
+        return (-1);
+    }
+#endif
+    can = (STM32F4XX_CAN_t *)dev->Base;
 
-        result   = size;
+    CPU_CRITICAL_ENTER();
+    if (enable != 0) {                                /* set or clear fifo message pending irqs   */
+        can->IER |=  (STM32F4XX_CAN_IER_FMPIE0 | STM32F4XX_CAN_IER_FMPIE1);
     } else {
-        DrvError = STM32F4XX_CAN_NO_DATA_ERR;
+        can->IER &= ~(STM32F4XX_CAN_IER_FMPIE0 | STM32F4XX_CAN_IER_FMPIE1);
     }
     CPU_CRITICAL_EXIT();
                                                       /*------------------------------------------*/
-    return (result);                                  /* Return function result                   */
+    return (0);                                       /* Return function result                   */
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*!
+* \brief    CAN TRANSMIT READY
+*
+* \ingroup  STM32F4XX_CAN
+*
+*           Check for an empty transmit mailbox. This is the fast alternative to the IO control
+*           function code IO_STM32F4XX_CAN_TX_READY, which is called for each transmitted frame.
+*
+* \param    paraId  parameter identifier, returned by XXXCANOpen()
+*
+* \return   transmit status (1 if a mailbox is empty, 0 if all mailboxes are pending, -1 if an
+*           error occurred)
+*/
+/*------------------------------------------------------------------------------------------------*/
+CPU_INT16S STM32F4XXCANTxReady (CPU_INT16S paraId)
+{
+    STM32F4XX_CAN_t    *can;                          /* Local: Pointer to can register           */
+                                                      /*------------------------------------------*/
+#if STM32F4XX_CAN_ARG_CHK_CFG > 0
+    if ((paraId >= STM32F4XX_CAN_N_DEV) || (paraId < 0)) { /* check that paraId is in range       */
+        DrvError = STM32F4XX_CAN_BUS_ERR;
+        return (-1);
+    }
+#endif
+    can = (STM32F4XX_CAN_t *)DevData[paraId].Base;
+    if ((can->TSR & (STM32F4XX_CAN_TSR_TME0 |         /* check for empty transmit mailbox         */
+                     STM32F4XX_CAN_TSR_TME1 |
+                     STM32F4XX_CAN_TSR_TME2)) != 0) {
+        return (1);
+    }
+                                                      /*------------------------------------------*/
+    return (0);                                       /* Return function result                   */
 }
 
 /*------------------------------------------------------------------------------------------------*/
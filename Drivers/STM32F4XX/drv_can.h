@@ -91,6 +91,21 @@
 #define STM32F4XX_FF_FRAME_BIT    0x20000000
 #define STM32F4XX_RTR_FRAME_BIT   0x40000000
 
+/*------------------------------------------------------------------------------------------------*/
+/*!
+* \brief    HARDWARE TIMESTAMP
+*
+* \ingroup  STM32F4XX_CAN
+*
+*           If enabled, the time triggered communication mode is activated and the 16 bit
+*           timestamp of the CAN controller (bit time resolution) is stored in the received
+*           CAN frames. This configuration must be used together with CANFRM_TIMESTAMP_EN = 2.
+*/
+/*------------------------------------------------------------------------------------------------*/
+#ifndef STM32F4XX_CAN_TIMESTAMP_CFG
+#define STM32F4XX_CAN_TIMESTAMP_CFG  0
+#endif
+
 /*
 ****************************************************************************************************
 *                                            DATA TYPES
@@ -428,6 +443,16 @@ typedef struct {
     */
     /*--------------------------------------------------------------------------------------------*/
     CPU_INT08U Spare[3];
+#if STM32F4XX_CAN_TIMESTAMP_CFG > 0
+    /*--------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief    RECEIVE TIMESTAMP
+    *
+    *           This member holds the timestamp of the CAN controller at reception.
+    */
+    /*--------------------------------------------------------------------------------------------*/
+    CPU_INT32U Timestamp;
+#endif
 } STM32F4XX_CANFRM;
 
 /*
@@ -441,6 +466,9 @@ CPU_INT16S STM32F4XXCANOpen  (CPU_INT16S drvId, CPU_INT32U devName, CPU_INT16U m
 CPU_INT16S STM32F4XXCANClose (CPU_INT16S paraId);
 CPU_INT16S STM32F4XXCANIoCtl (CPU_INT16S paraId, CPU_INT16U func, void *argp);
 CPU_INT16S STM32F4XXCANRead  (CPU_INT16S paraId, CPU_INT08U *buffer, CPU_INT16U size);
+CPU_INT16S STM32F4XXCANReadN (CPU_INT16S paraId, CPU_INT08U *buffer, CPU_INT16U size, CPU_INT16U num);
+CPU_INT16S STM32F4XXCANRxIrq (CPU_INT16S paraId, CPU_INT08U enable);
+CPU_INT16S STM32F4XXCANTxReady (CPU_INT16S paraId);
 CPU_INT16S STM32F4XXCANWrite (CPU_INT16S paraId, CPU_INT08U *buffer, CPU_INT16U size);
 
 CPU_INT16S STM32F4XXCAN_CalcTimingReg (STM32F4XX_CAN_DATA *data);
@@ -456,4 +484,8 @@ void       STM32F4XXCAN_PinCfg        (CPU_INT32U arg);
 #error "STM32F4XX/drv_can.h : The configuration STM32F4XX_CAN_ARG_CHK_CFG must be 0 or 1"
 #endif
 
+#if ((STM32F4XX_CAN_TIMESTAMP_CFG) < 0 || (STM32F4XX_CAN_TIMESTAMP_CFG > 1))
+#error "STM32F4XX/drv_can.h : The configuration STM32F4XX_CAN_TIMESTAMP_CFG must be 0 or 1"
+#endif
+
 #endif
@@ -84,6 +84,10 @@
 #define STM32F4XX_CAN_RF1R_FOVR1   ((CPU_INT32U)0x00000010) /* FIFO 1 overrun                     */
 #define STM32F4XX_CAN_RF1R_RFOM1   ((CPU_INT32U)0x00000020) /* Release FIFO 1 output mailbox      */
 
+/* Interrupt Enable Register bits */
+#define STM32F4XX_CAN_IER_FMPIE0   ((CPU_INT32U)0x00000002) /* FIFO 0 message pending interrupt   */
+#define STM32F4XX_CAN_IER_FMPIE1   ((CPU_INT32U)0x00000010) /* FIFO 1 message pending interrupt   */
+
 /* Error Status Register bits */
 #define STM32F4XX_CAN_ESR_EWGF     ((CPU_INT32U)0x00000001) /* Error warning flag                 */
 #define STM32F4XX_CAN_ESR_EPVF     ((CPU_INT32U)0x00000002) /* Error passive flag                 */
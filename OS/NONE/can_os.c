@@ -36,6 +36,9 @@
 
 #include "can_os.h"                                   /* CAN OS abstraction layer                      */
 #include "can_err.h"                                  /* CAN error codes                               */
+#if CANFRM_TIMESTAMP_EN > 0
+#include "cpu_core.h"                                 /* CPU timestamp services                        */
+#endif
 #include "bsp.h"                                      /* timer function                                */
 #include "cpu.h"
 
@@ -69,6 +72,15 @@ typedef struct semaphore {
 
 CAN_SEM   CANOS_TxSem[CANBUS_N];
 CAN_SEM   CANOS_RxSem[CANBUS_N];
+#if CANBUS_SUB_EN > 0
+CAN_SEM   CANOS_SubSem[CANBUS_SUB_N];
+#endif
+#if CANBUS_WAIT_EN > 0
+volatile  CPU_INT32U  CANOS_RxFlags;
+#endif
+#if CANBUS_RX_DEFER_EN > 0
+CAN_SEM   CANOS_SrvSem;
+#endif
 
 
 /*
@@ -104,13 +116,24 @@ extern  CPU_INT32U  BSPTimeGet (void);
 
 CPU_INT16S  CANOS_Init (void)
 {
-    CPU_INT08U  i;                                    /* Local: loop variable                          */
+    CPU_INT16U  i;                                    /* Local: loop variable                          */
 
 
     for (i = 0u; i < CANBUS_N; i++) {                 /* loop through all busses                       */
-        CANOS_TxSem[i].count = CANBUS_TX_QSIZE - 1u;  /* Initialize TX buffer counting semaphore       */
+        CANOS_TxSem[i].count = CANBUS_TX_QSIZE;       /* Initialize TX buffer counting semaphore       */
         CANOS_RxSem[i].count = 0u;                    /* Initialize RX buffer counting semaphore       */
     }
+#if CANBUS_SUB_EN > 0
+    for (i = 0u; i < CANBUS_SUB_N; i++) {             /* loop through all receive subscribers          */
+        CANOS_SubSem[i].count = 0u;                   /* Initialize subscriber counting semaphore      */
+    }
+#endif
+#if CANBUS_WAIT_EN > 0
+    CANOS_RxFlags = 0u;                               /* Initialize receive indications of all busses  */
+#endif
+#if CANBUS_RX_DEFER_EN > 0
+    CANOS_SrvSem.count = 0u;                          /* Initialize receive service semaphore          */
+#endif
 
     return CAN_ERR_NONE;                              /* return function result                        */
 }
@@ -155,13 +178,16 @@ void  CANOS_ResetRx (CPU_INT16S  busId)
 *
 * Argument(s) : busId    identifies CAN bus
 *
+*               size     number of free entries in the transmit buffer
+*
 * Return(s)   : None.
 *
 * Note(s)     : None.
 *********************************************************************************************************
 */
 
-void  CANOS_ResetTx (CPU_INT16S  busId)
+void  CANOS_ResetTx (CPU_INT16S  busId,
+                     CPU_INT16U  size)
 {
     CPU_SR_ALLOC();
 
@@ -173,7 +199,7 @@ void  CANOS_ResetTx (CPU_INT16S  busId)
 #endif
 
     CPU_CRITICAL_ENTER();
-    CANOS_TxSem[(CPU_INT16U)busId].count = CANBUS_TX_QSIZE - 1u;
+    CANOS_TxSem[(CPU_INT16U)busId].count = size;
     CPU_CRITICAL_EXIT();
 }
 
@@ -257,6 +283,91 @@ CPU_INT08U  CANOS_PendRxFrame (CPU_INT16U  timeout,
 }
 
 
+/*
+*********************************************************************************************************
+*                                         CANOS_PendRxFrameN()
+*
+* Description : This function shall wait for at least one CAN frame within the CAN receive buffer. If a
+*               timeout of 0 ticks is given, this function shall wait forever, otherwise this function
+*               shall wait for maximal timeout ticks. After a successful wait, all further available
+*               frames (up to the given maximum) are taken with a single semaphore counter update.
+*
+* Argument(s) : timeout    Timeout in time ticks as provided by the board support package
+*
+*               busId      identifies CAN bus
+*
+*               max        maximal number of frames, which shall be taken
+*
+* Return(s)   : Number of received frames (0 = no frame received until timeout).
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+CPU_INT16U  CANOS_PendRxFrameN (CPU_INT16U  timeout,
+                                CPU_INT16S  busId,
+                                CPU_INT16U  max)
+{
+    CPU_INT32U  cnt;                                  /* Local: semaphore count                        */
+    CPU_INT32U  time;                                 /* Local: actual time                            */
+    CPU_INT32U  start;                                /* Local: timeout start time                     */
+    CPU_INT32U  end;                                  /* Local: timeout end time                       */
+    CPU_SR_ALLOC();
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return (0u);
+    }
+#endif
+    if (max == 0u) {                                  /* see, if no frame is requested                 */
+        return (0u);
+    }
+
+    CPU_CRITICAL_ENTER();
+    cnt = CANOS_RxSem[(CPU_INT16U)busId].count;
+    CPU_CRITICAL_EXIT();
+
+    if (cnt == 0u) {
+        if (timeout == 0u) {                          /* blocking wait                                 */
+            do {
+                CPU_CRITICAL_ENTER();
+                cnt = CANOS_RxSem[(CPU_INT16U)busId].count;
+                CPU_CRITICAL_EXIT();
+            } while (cnt == 0u);
+
+        } else {                                      /* wait with timeout                             */
+
+            start = BSPTimeGet();
+            end   = start + timeout;
+            do {
+                CPU_CRITICAL_ENTER();
+                cnt = CANOS_RxSem[(CPU_INT16U)busId].count;
+                CPU_CRITICAL_EXIT();
+
+                time = BSPTimeGet();
+            } while ((cnt == 0u) && (time < end));
+
+            if (cnt == 0u) {
+                can_errnum = CAN_ERR_OSSEMPEND;       /* set error indication                          */
+            }
+        }
+    }
+    if (cnt > 0u) {
+        CPU_CRITICAL_ENTER();
+        cnt = CANOS_RxSem[(CPU_INT16U)busId].count;   /* get all received frames                       */
+        if (cnt > max) {                              /* limit to the requested number of frames       */
+            cnt = max;
+        }
+        CANOS_RxSem[(CPU_INT16U)busId].count -= cnt;  /* take these frames at once                     */
+        CPU_CRITICAL_EXIT();
+    }
+
+    return ((CPU_INT16U)cnt);                         /* return function result                        */
+}
+
+
 /*
 *********************************************************************************************************
 *                                         CANOS_PostRxFrame()
@@ -288,6 +399,41 @@ void  CANOS_PostRxFrame (CPU_INT16S  busId)
 }
 
 
+/*
+*********************************************************************************************************
+*                                         CANOS_PostRxFrameN()
+*
+* Description : This function shall signal multiple CAN frames within the CAN receive buffer.
+*
+* Argument(s) : busId     identifies CAN bus
+*
+*               num       number of received frames
+*
+* Return(s)   : None.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+void  CANOS_PostRxFrameN (CPU_INT16S  busId,
+                          CPU_INT16U  num)
+{
+    CPU_SR_ALLOC();
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) {  /* is busId out of range?                   */
+        can_errnum = CAN_ERR_BUSID;
+        return;
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();
+    CANOS_RxSem[(CPU_INT16U)busId].count += num;      /* signal all frames at once                     */
+    CPU_CRITICAL_EXIT();
+}
+
+
 /*
 *********************************************************************************************************
 *                                         CANOS_PendTxFrame()
@@ -367,6 +513,91 @@ CPU_INT08U  CANOS_PendTxFrame (CPU_INT16U  timeout,
 }
 
 
+/*
+*********************************************************************************************************
+*                                         CANOS_PendTxFrameN()
+*
+* Description : This function shall wait for at least one free space within the transmit buffer. If a
+*               timeout of 0 ticks is given, this function shall wait forever, otherwise this function
+*               shall wait for maximal timeout ticks. After a successful wait, all further free spaces
+*               (up to the given maximum) are reserved with a single semaphore counter update.
+*
+* Argument(s) : timeout    Timeout in time ticks as provided by the board support package
+*
+*               busId      identifies CAN bus
+*
+*               max        maximal number of frames, which shall be reserved
+*
+* Return(s)   : Number of reserved frames (0 = no space for a frame until timeout).
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+CPU_INT16U  CANOS_PendTxFrameN (CPU_INT16U  timeout,
+                                CPU_INT16S  busId,
+                                CPU_INT16U  max)
+{
+    CPU_INT32U  cnt;                                  /* Local: semaphore count                        */
+    CPU_INT32U  time;                                 /* Local: actual time                            */
+    CPU_INT32U  start;                                /* Local: timeout start time                     */
+    CPU_INT32U  end;                                  /* Local: timeout end time                       */
+    CPU_SR_ALLOC();
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return (0u);
+    }
+#endif
+    if (max == 0u) {                                  /* see, if no frame is requested                 */
+        return (0u);
+    }
+
+    CPU_CRITICAL_ENTER();
+    cnt = CANOS_TxSem[(CPU_INT16U)busId].count;
+    CPU_CRITICAL_EXIT();
+
+    if (cnt == 0u) {
+        if (timeout == 0u) {                          /* blocking wait                                 */
+            do {
+                CPU_CRITICAL_ENTER();
+                cnt = CANOS_TxSem[(CPU_INT16U)busId].count;
+                CPU_CRITICAL_EXIT();
+            } while (cnt == 0u);
+
+        } else {                                      /* wait with timeout                             */
+
+            start = BSPTimeGet();
+            end   = start + timeout;
+            do {
+                CPU_CRITICAL_ENTER();
+                cnt = CANOS_TxSem[(CPU_INT16U)busId].count;
+                CPU_CRITICAL_EXIT();
+
+                time = BSPTimeGet();
+            } while ((cnt == 0u) && (time < end));
+
+            if (cnt == 0u) {
+                can_errnum = CAN_ERR_OSSEMPEND;       /* set error indication                          */
+            }
+        }
+    }
+    if (cnt > 0u) {
+        CPU_CRITICAL_ENTER();
+        cnt = CANOS_TxSem[(CPU_INT16U)busId].count;   /* get all free spaces                           */
+        if (cnt > max) {                              /* limit to the requested number of frames       */
+            cnt = max;
+        }
+        CANOS_TxSem[(CPU_INT16U)busId].count -= cnt;  /* reserve these spaces at once                  */
+        CPU_CRITICAL_EXIT();
+    }
+
+    return ((CPU_INT16U)cnt);                         /* return function result                        */
+}
+
+
 /*
 *********************************************************************************************************
 *                                         CANOS_PostTxFrame()
@@ -398,6 +629,356 @@ void  CANOS_PostTxFrame (CPU_INT16S  busId)
 }
 
 
+/*
+*********************************************************************************************************
+*                                         CANOS_PostTxFrameN()
+*
+* Description : This function shall release multiple CAN frame reservations within the CAN transmit
+*               buffer.
+*
+* Argument(s) : busId     identifies CAN bus
+*
+*               num       number of released frame reservations
+*
+* Return(s)   : None.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+void  CANOS_PostTxFrameN (CPU_INT16S  busId,
+                          CPU_INT16U  num)
+{
+    CPU_SR_ALLOC();
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) {  /* is busId out of range?                   */
+        can_errnum = CAN_ERR_BUSID;
+        return;
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();
+    CANOS_TxSem[(CPU_INT16U)busId].count += num;      /* release all reservations at once              */
+    CPU_CRITICAL_EXIT();
+}
+
+
+#if CANBUS_SUB_EN > 0
+/*
+*********************************************************************************************************
+*                                         CANOS_ResetSub()
+*
+* Description : This function resets the semaphore of a receive subscriber.
+*
+* Argument(s) : subId    identifies receive subscriber
+*
+* Return(s)   : None.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+void  CANOS_ResetSub (CPU_INT16S  subId)
+{
+    CPU_SR_ALLOC();
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((subId < 0) || ((CPU_INT16U)subId >= CANBUS_SUB_N)) { /* is subId out of range?                */
+        can_errnum = CAN_ERR_SUBID;
+        return;
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();
+    CANOS_SubSem[(CPU_INT16U)subId].count = 0u;
+    CPU_CRITICAL_EXIT();
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CANOS_PendSubFrame()
+*
+* Description : This function shall wait for a CAN frame within the queue of a receive subscriber. If
+*               a timeout of 0 ticks is given, this function shall wait forever, otherwise this
+*               function shall wait for maximal timeout ticks.
+*
+* Argument(s) : timeout    Timeout in time ticks as provided by the board support package
+*
+*               subId      identifies receive subscriber
+*
+* Return(s)   : Indication of a received frame:
+*
+*                   1 = at least one frame is received
+*                   0 = no frame received until timeout
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  CANOS_PendSubFrame (CPU_INT16U  timeout,
+                                CPU_INT16S  subId)
+{
+    CPU_INT32U  cnt;                                  /* Local: semaphore count                        */
+    CPU_INT32U  time;                                 /* Local: actual time                            */
+    CPU_INT32U  end;                                  /* Local: timeout end time                       */
+    CPU_INT08U  result = 0u;                          /* Local: Function result                        */
+    CPU_SR_ALLOC();
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((subId < 0) || ((CPU_INT16U)subId >= CANBUS_SUB_N)) { /* is subId out of range?                */
+        can_errnum = CAN_ERR_SUBID;
+        return (0u);
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();
+    cnt = CANOS_SubSem[(CPU_INT16U)subId].count;
+    CPU_CRITICAL_EXIT();
+
+    if (cnt == 0u) {
+        if (timeout == 0u) {                          /* blocking wait                                 */
+            do {
+                CPU_CRITICAL_ENTER();
+                cnt = CANOS_SubSem[(CPU_INT16U)subId].count;
+                CPU_CRITICAL_EXIT();
+            } while (cnt == 0u);
+
+        } else {                                      /* wait with timeout                             */
+
+            end = BSPTimeGet() + timeout;
+            do {
+                CPU_CRITICAL_ENTER();
+                cnt = CANOS_SubSem[(CPU_INT16U)subId].count;
+                CPU_CRITICAL_EXIT();
+
+                time = BSPTimeGet();
+            } while ((cnt == 0u) && (time < end));
+
+            if (cnt == 0u) {
+                can_errnum = CAN_ERR_OSSEMPEND;       /* set error indication                          */
+            }
+        }
+    }
+    if (cnt > 0u) {
+        CPU_CRITICAL_ENTER();
+        CANOS_SubSem[(CPU_INT16U)subId].count--;      /* decrement  semaphore count                    */
+        CPU_CRITICAL_EXIT();
+        result     = 1u;                              /* yes: there a frame in subscriber queue        */
+    }
+
+    return (result);                                  /* return function result                        */
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CANOS_PostSubFrame()
+*
+* Description : This function shall signal a CAN frame within the queue of a receive subscriber.
+*
+* Argument(s) : subId     identifies receive subscriber
+*
+* Return(s)   : None.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+void  CANOS_PostSubFrame (CPU_INT16S  subId)
+{
+    CPU_SR_ALLOC();
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((subId < 0) || ((CPU_INT16U)subId >= CANBUS_SUB_N)) { /* is subId out of range?                */
+        can_errnum = CAN_ERR_SUBID;
+        return;
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();
+    CANOS_SubSem[(CPU_INT16U)subId].count++;
+    CPU_CRITICAL_EXIT();
+}
+#endif                                                /* CANBUS_SUB_EN > 0                             */
+
+
+#if CANBUS_WAIT_EN > 0
+/*
+*********************************************************************************************************
+*                                         CANOS_PostRxFlag()
+*
+* Description : This function shall indicate received CAN frames within the receive buffer of a bus
+*               to a task, which waits for several busses.
+*
+* Argument(s) : busId     identifies CAN bus
+*
+* Return(s)   : None.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+void  CANOS_PostRxFlag (CPU_INT16S  busId)
+{
+    CPU_SR_ALLOC();
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return;
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();
+    CANOS_RxFlags |= (1uL << (CPU_INT16U)busId);      /* mark bus with received frames                 */
+    CPU_CRITICAL_EXIT();
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CANOS_ClrRxFlags()
+*
+* Description : This function clears the receive indications of the given busses.
+*
+* Argument(s) : mask      bitmask of busses (bit n = bus n)
+*
+* Return(s)   : None.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+void  CANOS_ClrRxFlags (CPU_INT32U  mask)
+{
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    CANOS_RxFlags &= ~mask;                           /* clear indications of given busses             */
+    CPU_CRITICAL_EXIT();
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CANOS_PendRxFlags()
+*
+* Description : This function shall wait for a receive indication of at least one of the given busses.
+*               If a timeout of 0 ticks is given, this function shall wait forever, otherwise this
+*               function shall wait for maximal timeout ticks. The returned indications are cleared.
+*
+* Argument(s) : timeout    Timeout in time ticks as provided by the board support package
+*
+*               mask       bitmask of busses (bit n = bus n)
+*
+* Return(s)   : Bitmask of busses with a receive indication (0 = no indication until timeout).
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  CANOS_PendRxFlags (CPU_INT16U  timeout,
+                               CPU_INT32U  mask)
+{
+    CPU_INT32U  flags;                                /* Local: set flags of given busses              */
+    CPU_INT32U  end;                                  /* Local: timeout end time                       */
+    CPU_SR_ALLOC();
+
+
+    end = BSPTimeGet() + timeout;
+    do {
+        CPU_CRITICAL_ENTER();
+        flags = CANOS_RxFlags & mask;                 /* get flags of given busses                     */
+        CANOS_RxFlags &= ~flags;                      /* consume these flags                           */
+        CPU_CRITICAL_EXIT();
+    } while ((flags == 0u) &&                         /* wait forever or until timeout                 */
+             ((timeout == 0u) || (BSPTimeGet() < end)));
+
+    if (flags == 0u) {
+        can_errnum = CAN_ERR_OSSEMPEND;               /* set error indication                          */
+    }
+    return (flags);                                   /* return ready busses                           */
+}
+#endif                                                /* CANBUS_WAIT_EN > 0                            */
+
+
+#if CANBUS_RX_DEFER_EN > 0
+/*
+*********************************************************************************************************
+*                                        CANOS_PendRxService()
+*
+* Description : This function shall wait for staged CAN frames of any bus. If a timeout of 0 ticks is
+*               given, this function shall wait forever, otherwise this function shall wait for maximal
+*               timeout ticks. All pending indications are consumed with a single call.
+*
+* Argument(s) : timeout    Timeout in time ticks as provided by the board support package
+*
+* Return(s)   : Indication of staged frames:
+*
+*                   1 = at least one bus has staged frames
+*                   0 = no indication until timeout
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  CANOS_PendRxService (CPU_INT16U  timeout)
+{
+    CPU_INT32U  cnt;                                  /* Local: semaphore count                        */
+    CPU_INT32U  end;                                  /* Local: timeout end time                       */
+    CPU_SR_ALLOC();
+
+
+    end = BSPTimeGet() + timeout;
+    do {
+        CPU_CRITICAL_ENTER();
+        cnt = CANOS_SrvSem.count;
+        CANOS_SrvSem.count = 0u;                      /* consume all indications                       */
+        CPU_CRITICAL_EXIT();
+    } while ((cnt == 0u) && ((timeout == 0u) || (BSPTimeGet() < end)));
+
+    if (cnt == 0u) {
+        can_errnum = CAN_ERR_OSSEMPEND;               /* set error indication                          */
+        return (0u);
+    }
+    return (1u);                                      /* return function result                        */
+}
+
+
+/*
+*********************************************************************************************************
+*                                        CANOS_PostRxService()
+*
+* Description : This function shall indicate staged CAN frames to the receive service task.
+*
+* Argument(s) : None.
+*
+* Return(s)   : None.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+void  CANOS_PostRxService (void)
+{
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    CANOS_SrvSem.count++;
+    CPU_CRITICAL_EXIT();
+}
+#endif                                                /* CANBUS_RX_DEFER_EN > 0                        */
+
+
 /*
 *********************************************************************************************************
 *                                           CANOS_GetTime()
@@ -419,6 +1000,34 @@ CPU_INT32U  CANOS_GetTime (void)
 }
 
 
+/*
+*********************************************************************************************************
+*                                         CANOS_GetTimestamp()
+*
+* Description : This function shall receive a high resolution timestamp for received CAN frames. The
+*               free running 32 bit timestamp of uC/CPU is used, when it is enabled. Otherwise the
+*               time of the OS is used (see CANOS_GetTime()).
+*
+* Argument(s) : None.
+*
+* Return(s)   : 32 bit value that represent the timestamp.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+#if CANFRM_TIMESTAMP_EN > 0
+CPU_INT32U  CANOS_GetTimestamp (void)
+{
+#if (CPU_CFG_TS_32_EN == DEF_ENABLED)
+    return ((CPU_INT32U)CPU_TS_Get32());              /* free running timestamp of uC/CPU              */
+#else
+    return (CANOS_GetTime());                         /* fallback: time in resolution of the OS        */
+#endif
+}
+#endif                                                /* CANFRM_TIMESTAMP_EN > 0                       */
+
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
@@ -27,6 +27,22 @@
 
 #include "can_os.h"                                   /* CAN OS abstraction layer                      */
 #include "can_err.h"                                  /* CAN error codes                               */
+#if CANFRM_TIMESTAMP_EN > 0
+#include "cpu_core.h"                                 /* CPU timestamp services                        */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL CONFIGURATION ERRORS
+*********************************************************************************************************
+*/
+
+#if CANBUS_WAIT_EN > 0
+#if  (OS_CFG_FLAG_EN < 1u)
+#error "OS_CFG_FLAG_EN is invalid; check definition in os_cfg.h to be 1 when CANBUS_WAIT_EN is 1!"
+#endif
+#endif
 
 
 /*
@@ -47,6 +63,15 @@
 
 OS_SEM    CANOS_TxSem[CANBUS_N];
 OS_SEM    CANOS_RxSem[CANBUS_N];
+#if CANBUS_SUB_EN > 0
+OS_SEM    CANOS_SubSem[CANBUS_SUB_N];
+#endif
+#if CANBUS_WAIT_EN > 0
+OS_FLAG_GRP  CANOS_RxFlag;
+#endif
+#if CANBUS_RX_DEFER_EN > 0
+OS_SEM    CANOS_SrvSem;
+#endif
 
 
 /*
@@ -74,14 +99,14 @@ OS_SEM    CANOS_RxSem[CANBUS_N];
 
 CPU_INT16S  CANOS_Init (void)
 {
-    CPU_INT08U  i;                                    /* Local: loop variable                          */
+    CPU_INT16U  i;                                    /* Local: loop variable                          */
     CPU_INT16U  err;                                  /* Local: Errorcode of OS function               */
 
 
     for (i=0u; i < CANBUS_N; i++) {                   /* loop through all busses                       */
         OSSemCreate (&CANOS_TxSem[i],                 /* Initialize TX counting semaphore              */
                      "CANOS_TxSem",
-                     (CANBUS_TX_QSIZE - 1u),
+                     CANBUS_TX_QSIZE,
                      &err);
 
         if (err != OS_ERR_NONE) {                     /* Check result                                  */
@@ -98,6 +123,41 @@ CPU_INT16S  CANOS_Init (void)
             return CAN_ERR_OSSEM;                     /* and leave initialization with errorcode       */
         }
     }                                                 /*-----------------------------------------------*/
+#if CANBUS_SUB_EN > 0
+    for (i = 0u; i < CANBUS_SUB_N; i++) {             /* loop through all receive subscribers          */
+        OSSemCreate (&CANOS_SubSem[i],                /* Initialize subscriber counting semaphore      */
+                     "CANOS_SubSem",
+                     0u,
+                     &err);
+
+        if (err != OS_ERR_NONE) {                     /* Check result                                  */
+            can_errnum = CAN_ERR_OSSEM;
+            return CAN_ERR_OSSEM;                     /* and leave initialization with errorcode       */
+        }
+    }
+#endif
+#if CANBUS_WAIT_EN > 0
+    OSFlagCreate (&CANOS_RxFlag,                      /* Initialize receive indications of all busses  */
+                  "CANOS_RxFlag",
+                  (OS_FLAGS)0,
+                  &err);
+
+    if (err != OS_ERR_NONE) {                         /* Check result                                  */
+        can_errnum = CAN_ERR_OSSEM;
+        return CAN_ERR_OSSEM;                         /* and leave initialization with errorcode       */
+    }
+#endif
+#if CANBUS_RX_DEFER_EN > 0
+    OSSemCreate (&CANOS_SrvSem,                       /* Initialize receive service semaphore          */
+                 "CANOS_SrvSem",
+                 0u,
+                 &err);
+
+    if (err != OS_ERR_NONE) {                         /* Check result                                  */
+        can_errnum = CAN_ERR_OSSEM;
+        return CAN_ERR_OSSEM;                         /* and leave initialization with errorcode       */
+    }
+#endif
     return CAN_ERR_NONE;                              /* return function result                        */
 }
 
@@ -144,6 +204,8 @@ void  CANOS_ResetRx (CPU_INT16S  busId)
 *
 * Argument(s) : busId    identifies CAN bus
 *
+*               size     number of free entries in the transmit buffer
+*
 * Return(s)   : None.
 *
 * Note(s)     : This function is a wrapper around the wanted operating system. The following
@@ -151,7 +213,8 @@ void  CANOS_ResetRx (CPU_INT16S  busId)
 *********************************************************************************************************
 */
 
-void  CANOS_ResetTx (CPU_INT16S  busId)
+void  CANOS_ResetTx (CPU_INT16S  busId,
+                     CPU_INT16U  size)
 {
     CPU_INT16U  err;                                  /* Local: Errorcode of OS function               */
 
@@ -164,7 +227,7 @@ void  CANOS_ResetTx (CPU_INT16S  busId)
 #endif
 
     OSSemSet(&CANOS_TxSem[(CPU_INT16U)busId],         /* reset semaphore counter value                 */
-             CANBUS_TX_QSIZE - 1u,
+             size,
              &err);
     if (err != CANOS_NO_ERR) {                        /* see, if no error is detected                  */
         can_errnum = CAN_ERR_OSSEM;                   /* set error indication                          */
@@ -224,6 +287,72 @@ CPU_INT08U  CANOS_PendRxFrame (CPU_INT16U  timeout,
 }
 
 
+/*
+*********************************************************************************************************
+*                                         CANOS_PendRxFrameN()
+*
+* Description : This function shall wait for at least one CAN frame within the CAN receive buffer. If a
+*               timeout of 0 ticks is given, this function shall wait forever, otherwise this function
+*               shall wait for maximal timeout ticks. After a successful wait, all further available
+*               frames (up to the given maximum) are taken with a single semaphore counter update.
+*
+* Argument(s) : timeout    Timeout in OS time ticks
+*
+*               busId      identifies CAN bus
+*
+*               max        maximal number of frames, which shall be taken
+*
+* Return(s)   : Number of received frames (0 = no frame received until timeout).
+*
+* Note(s)     : This function is a wrapper around the wanted operating system. The following
+*               implementation is an implementation for uC/OS-III.
+*********************************************************************************************************
+*/
+
+CPU_INT16U  CANOS_PendRxFrameN (CPU_INT16U  timeout,
+                                CPU_INT16S  busId,
+                                CPU_INT16U  max)
+{
+    OS_SEM      *sem;                                 /* Local: Pointer to receive semaphore           */
+    OS_SEM_CTR   cnt;                                 /* Local: additional available frames            */
+    CPU_INT16U   result = 0u;                         /* Local: Function result                        */
+    CPU_INT16U   err;                                 /* Local: Errorcode of OS function               */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return (0u);
+    }
+#endif
+    if (max == 0u) {                                  /* see, if no frame is requested                 */
+        return (0u);
+    }
+
+    sem = &CANOS_RxSem[(CPU_INT16U)busId];            /* set pointer to receive semaphore              */
+    OSSemPend (sem,                                   /* Wait for a received frame with timeout        */
+               timeout,
+               OS_OPT_PEND_BLOCKING,
+               (CPU_TS *)0,
+               &err);
+
+    if (err == CANOS_NO_ERR) {                        /* see, if no error is detected                  */
+        CPU_CRITICAL_ENTER();                         /* disable all interrupts                        */
+        cnt = sem->Ctr;                               /* get number of further received frames         */
+        if (cnt > (OS_SEM_CTR)(max - 1u)) {           /* limit to the requested number of frames       */
+            cnt = (OS_SEM_CTR)(max - 1u);
+        }
+        sem->Ctr -= cnt;                              /* take these frames at once                     */
+        CPU_CRITICAL_EXIT();                          /* enable all interrupts                         */
+        result = (CPU_INT16U)cnt + 1u;                /* yes: frames in receive buffer                 */
+    } else {                                          /* otherwise: an error is detected               */
+        can_errnum = CAN_ERR_OSSEMPEND;               /* set error indication                          */
+    }
+    return (result);                                  /* return function result                        */
+}
+
+
 /*
 *********************************************************************************************************
 *                                         CANOS_PostRxFrame()
@@ -260,6 +389,58 @@ void  CANOS_PostRxFrame (CPU_INT16S  busId)
 }
 
 
+/*
+*********************************************************************************************************
+*                                         CANOS_PostRxFrameN()
+*
+* Description : This function shall signal multiple CAN frames within the CAN receive buffer.
+*
+* Argument(s) : busId     identifies CAN bus
+*
+*               num       number of received frames
+*
+* Return(s)   : None.
+*
+* Note(s)     : This function is a wrapper around the wanted operating system. The following
+*               implementation is an implementation for uC/OS-III.
+*********************************************************************************************************
+*/
+
+void  CANOS_PostRxFrameN (CPU_INT16S  busId,
+                          CPU_INT16U  num)
+{
+    OS_SEM      *sem;                                 /* Local: Pointer to receive semaphore           */
+    CPU_INT16U   err;                                 /* Local: OS error code                          */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return;
+    }
+#endif
+
+    sem = &CANOS_RxSem[(CPU_INT16U)busId];            /* set pointer to receive semaphore              */
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    if (sem->PendList.NbrEntries == 0u) {             /* see, if no task is waiting for the semaphore  */
+        sem->Ctr += num;                              /* yes: signal all frames at once                */
+        num       = 0u;
+    }
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
+
+    while (num > 0u) {                                /* signal frames to waiting tasks                */
+        OSSemPost (sem,
+                   OS_OPT_POST_ALL,
+                   &err);
+        if (err != CAN_ERR_NONE) {                    /* see, if no error is detected                  */
+            can_errnum = CAN_ERR_OSSEMPOST;           /* set error indication                          */
+        }
+        num--;
+    }
+}
+
+
 /*
 *********************************************************************************************************
 *                                         CANOS_PendTxFrame()
@@ -312,6 +493,72 @@ CPU_INT08U  CANOS_PendTxFrame (CPU_INT16U  timeout,
 }
 
 
+/*
+*********************************************************************************************************
+*                                         CANOS_PendTxFrameN()
+*
+* Description : This function shall wait for at least one free space within the transmit buffer. If a
+*               timeout of 0 ticks is given, this function shall wait forever, otherwise this function
+*               shall wait for maximal timeout ticks. After a successful wait, all further free spaces
+*               (up to the given maximum) are reserved with a single semaphore counter update.
+*
+* Argument(s) : timeout    Timeout in OS time ticks
+*
+*               busId      identifies CAN bus
+*
+*               max        maximal number of frames, which shall be reserved
+*
+* Return(s)   : Number of reserved frames (0 = no space for a frame until timeout).
+*
+* Note(s)     : This function is a wrapper around the wanted operating system. The following
+*               implementation is an implementation for uC/OS-III.
+*********************************************************************************************************
+*/
+
+CPU_INT16U  CANOS_PendTxFrameN (CPU_INT16U  timeout,
+                                CPU_INT16S  busId,
+                                CPU_INT16U  max)
+{
+    OS_SEM      *sem;                                 /* Local: Pointer to transmit semaphore          */
+    OS_SEM_CTR   cnt;                                 /* Local: additional free spaces                 */
+    CPU_INT16U   result = 0u;                         /* Local: Function result                        */
+    CPU_INT16U   err;                                 /* Local: Errorcode of OS function               */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return (0u);
+    }
+#endif
+    if (max == 0u) {                                  /* see, if no frame is requested                 */
+        return (0u);
+    }
+
+    sem = &CANOS_TxSem[(CPU_INT16U)busId];            /* set pointer to transmit semaphore             */
+    OSSemPend (sem,                                   /* Wait for space in transmit buffer             */
+               timeout,
+               OS_OPT_PEND_BLOCKING,
+               (CPU_TS *)0,
+               &err);
+
+    if (err == CANOS_NO_ERR) {                        /* see, if no error is detected                  */
+        CPU_CRITICAL_ENTER();                         /* disable all interrupts                        */
+        cnt = sem->Ctr;                               /* get number of further free spaces             */
+        if (cnt > (OS_SEM_CTR)(max - 1u)) {           /* limit to the requested number of frames       */
+            cnt = (OS_SEM_CTR)(max - 1u);
+        }
+        sem->Ctr -= cnt;                              /* reserve these spaces at once                  */
+        CPU_CRITICAL_EXIT();                          /* enable all interrupts                         */
+        result = (CPU_INT16U)cnt + 1u;                /* yes: space in transmit buffer                 */
+    } else {                                          /* otherwise: an error is detected               */
+        can_errnum = CAN_ERR_OSSEMPEND;               /* set error indication                          */
+    }
+    return (result);                                  /* return function result                        */
+}
+
+
 /*
 *********************************************************************************************************
 *                                         CANOS_PostTxFrame()
@@ -348,6 +595,367 @@ void  CANOS_PostTxFrame (CPU_INT16S  busId)
 }
 
 
+/*
+*********************************************************************************************************
+*                                         CANOS_PostTxFrameN()
+*
+* Description : This function shall release multiple CAN frame reservations within the CAN transmit
+*               buffer.
+*
+* Argument(s) : busId     identifies CAN bus
+*
+*               num       number of released frame reservations
+*
+* Return(s)   : None.
+*
+* Note(s)     : This function is a wrapper around the wanted operating system. The following
+*               implementation is an implementation for uC/OS-III.
+*********************************************************************************************************
+*/
+
+void  CANOS_PostTxFrameN (CPU_INT16S  busId,
+                          CPU_INT16U  num)
+{
+    OS_SEM      *sem;                                 /* Local: Pointer to transmit semaphore          */
+    CPU_INT16U   err;                                 /* Local: OS error code                          */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return;
+    }
+#endif
+
+    sem = &CANOS_TxSem[(CPU_INT16U)busId];            /* set pointer to transmit semaphore             */
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    if (sem->PendList.NbrEntries == 0u) {             /* see, if no task is waiting for the semaphore  */
+        sem->Ctr += num;                              /* yes: release all reservations at once         */
+        num       = 0u;
+    }
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
+
+    while (num > 0u) {                                /* release reservations to waiting tasks         */
+        OSSemPost (sem,
+                   OS_OPT_POST_ALL,
+                   &err);
+        if (err != CAN_ERR_NONE) {                    /* see, if no error is detected                  */
+            can_errnum = CAN_ERR_OSSEMPOST;           /* set error indication                          */
+        }
+        num--;
+    }
+}
+
+
+#if CANBUS_SUB_EN > 0
+/*
+*********************************************************************************************************
+*                                         CANOS_ResetSub()
+*
+* Description : This function resets the semaphore of a receive subscriber.
+*
+* Argument(s) : subId    identifies receive subscriber
+*
+* Return(s)   : None.
+*
+* Note(s)     : This function is a wrapper around the wanted operating system. The following
+*               implementation is an implementation for uC/OS-III.
+*********************************************************************************************************
+*/
+
+void  CANOS_ResetSub (CPU_INT16S  subId)
+{
+    CPU_INT16U  err;                                  /* Local: Errorcode of OS function               */
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((subId < 0) || ((CPU_INT16U)subId >= CANBUS_SUB_N)) { /* is subId out of range?                */
+        can_errnum = CAN_ERR_SUBID;
+        return;
+    }
+#endif
+
+    OSSemSet(&CANOS_SubSem[(CPU_INT16U)subId], 0u, &err); /* reset semaphore counter value              */
+    if (err != CANOS_NO_ERR) {                        /* see, if no error is detected                  */
+        can_errnum = CAN_ERR_OSSEM;                   /* set error indication                          */
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CANOS_PendSubFrame()
+*
+* Description : This function shall wait for a CAN frame within the queue of a receive subscriber. If
+*               a timeout of 0 ticks is given, this function shall wait forever, otherwise this
+*               function shall wait for maximal timeout ticks.
+*
+* Argument(s) : timeout    Timeout in OS time ticks
+*
+*               subId      identifies receive subscriber
+*
+* Return(s)   : Indication of a received frame:
+*
+*                   1 = at least one frame is received
+*                   0 = no frame received until timeout
+*
+* Note(s)     : This function is a wrapper around the wanted operating system. The following
+*               implementation is an implementation for uC/OS-III.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  CANOS_PendSubFrame (CPU_INT16U  timeout,
+                                CPU_INT16S  subId)
+{
+    CPU_INT08U  result;                               /* Local: Function result                        */
+    CPU_INT16U  err;                                  /* Local: Errorcode of OS function               */
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((subId < 0) || ((CPU_INT16U)subId >= CANBUS_SUB_N)) { /* is subId out of range?                */
+        can_errnum = CAN_ERR_SUBID;
+        return (0u);
+    }
+#endif
+
+    OSSemPend (&CANOS_SubSem[(CPU_INT16U)subId],      /* Wait for a received frame with timeout        */
+               timeout,
+               OS_OPT_PEND_BLOCKING,
+               (CPU_TS *)0,
+               &err);
+
+    if (err == CANOS_NO_ERR) {                        /* see, if no error is detected                  */
+        result     = 1u;                              /* yes: there a frame in subscriber queue        */
+    } else {                                          /* otherwise: an error is detected               */
+        can_errnum = CAN_ERR_OSSEMPEND;               /* set error indication                          */
+        result     = 0u;                              /* no frame in subscriber queue                  */
+    }
+    return (result);                                  /* return function result                        */
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CANOS_PostSubFrame()
+*
+* Description : This function shall signal a CAN frame within the queue of a receive subscriber.
+*
+* Argument(s) : subId     identifies receive subscriber
+*
+* Return(s)   : None.
+*
+* Note(s)     : This function is a wrapper around the wanted operating system. The following
+*               implementation is an implementation for uC/OS-III.
+*********************************************************************************************************
+*/
+
+void  CANOS_PostSubFrame (CPU_INT16S  subId)
+{
+    CPU_INT16U  err;                                  /* Local: OS error code                          */
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((subId < 0) || ((CPU_INT16U)subId >= CANBUS_SUB_N)) { /* is subId out of range?                */
+        can_errnum = CAN_ERR_SUBID;
+        return;
+    }
+#endif
+
+    OSSemPost (&CANOS_SubSem[(CPU_INT16U)subId],      /* signal a received frame                       */
+               OS_OPT_POST_ALL,
+               &err);
+
+    if (err != CAN_ERR_NONE) {                        /* see, if no error is detected                  */
+        can_errnum = CAN_ERR_OSSEMPOST;               /* set error indication                          */
+    }
+}
+#endif                                                /* CANBUS_SUB_EN > 0                             */
+
+
+#if CANBUS_WAIT_EN > 0
+/*
+*********************************************************************************************************
+*                                         CANOS_PostRxFlag()
+*
+* Description : This function shall indicate received CAN frames within the receive buffer of a bus
+*               to a task, which waits for several busses.
+*
+* Argument(s) : busId     identifies CAN bus
+*
+* Return(s)   : None.
+*
+* Note(s)     : This function is a wrapper around the wanted operating system. The following
+*               implementation is an implementation for uC/OS-III.
+*********************************************************************************************************
+*/
+
+void  CANOS_PostRxFlag (CPU_INT16S  busId)
+{
+    CPU_INT16U  err;                                  /* Local: OS error code                          */
+
+
+#if CANOS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return;
+    }
+#endif
+
+    (void)OSFlagPost(&CANOS_RxFlag,                   /* mark bus with received frames                 */
+                     (OS_FLAGS)(1uL << (CPU_INT16U)busId),
+                     OS_OPT_POST_FLAG_SET,
+                     &err);
+    if (err != CANOS_NO_ERR) {                        /* see, if no error is detected                  */
+        can_errnum = CAN_ERR_OSSEMPOST;               /* set error indication                          */
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CANOS_ClrRxFlags()
+*
+* Description : This function clears the receive indications of the given busses.
+*
+* Argument(s) : mask      bitmask of busses (bit n = bus n)
+*
+* Return(s)   : None.
+*
+* Note(s)     : This function is a wrapper around the wanted operating system. The following
+*               implementation is an implementation for uC/OS-III.
+*********************************************************************************************************
+*/
+
+void  CANOS_ClrRxFlags (CPU_INT32U  mask)
+{
+    CPU_INT16U  err;                                  /* Local: OS error code                          */
+
+
+    (void)OSFlagPost(&CANOS_RxFlag,                   /* clear indications of given busses             */
+                     (OS_FLAGS)mask,
+                     OS_OPT_POST_FLAG_CLR,
+                     &err);
+    if (err != CANOS_NO_ERR) {                        /* see, if no error is detected                  */
+        can_errnum = CAN_ERR_OSSEMPOST;               /* set error indication                          */
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CANOS_PendRxFlags()
+*
+* Description : This function shall wait for a receive indication of at least one of the given busses.
+*               If a timeout of 0 ticks is given, this function shall wait forever, otherwise this
+*               function shall wait for maximal timeout ticks. The returned indications are cleared.
+*
+* Argument(s) : timeout    Timeout in OS time ticks
+*
+*               mask       bitmask of busses (bit n = bus n)
+*
+* Return(s)   : Bitmask of busses with a receive indication (0 = no indication until timeout).
+*
+* Note(s)     : This function is a wrapper around the wanted operating system. The following
+*               implementation is an implementation for uC/OS-III.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  CANOS_PendRxFlags (CPU_INT16U  timeout,
+                               CPU_INT32U  mask)
+{
+    OS_FLAGS    flags;                                /* Local: set flags of given busses              */
+    CPU_INT16U  err;                                  /* Local: Errorcode of OS function               */
+
+
+    flags = OSFlagPend(&CANOS_RxFlag,                 /* wait for any of the given busses              */
+                       (OS_FLAGS)mask,
+                       timeout,
+                       OS_OPT_PEND_FLAG_SET_ANY + OS_OPT_PEND_FLAG_CONSUME + OS_OPT_PEND_BLOCKING,
+                       (CPU_TS *)0,
+                       &err);
+    if (err != CANOS_NO_ERR) {                        /* see, if an error is detected                  */
+        can_errnum = CAN_ERR_OSSEMPEND;               /* set error indication                          */
+        flags      = 0u;
+    }
+    return ((CPU_INT32U)flags);                       /* return ready busses                           */
+}
+#endif                                                /* CANBUS_WAIT_EN > 0                            */
+
+
+#if CANBUS_RX_DEFER_EN > 0
+/*
+*********************************************************************************************************
+*                                        CANOS_PendRxService()
+*
+* Description : This function shall wait for staged CAN frames of any bus. If a timeout of 0 ticks is
+*               given, this function shall wait forever, otherwise this function shall wait for maximal
+*               timeout ticks. All pending indications are consumed with a single call.
+*
+* Argument(s) : timeout    Timeout in OS time ticks
+*
+* Return(s)   : Indication of staged frames:
+*
+*                   1 = at least one bus has staged frames
+*                   0 = no indication until timeout
+*
+* Note(s)     : This function is a wrapper around the wanted operating system. The following
+*               implementation is an implementation for uC/OS-III.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  CANOS_PendRxService (CPU_INT16U  timeout)
+{
+    CPU_INT16U  err;                                  /* Local: Errorcode of OS function               */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+    OSSemPend (&CANOS_SrvSem,                         /* Wait for staged frames with timeout           */
+               timeout,
+               OS_OPT_PEND_BLOCKING,
+               (CPU_TS *)0,
+               &err);
+    if (err != CANOS_NO_ERR) {                        /* see, if an error is detected                  */
+        can_errnum = CAN_ERR_OSSEMPEND;               /* set error indication                          */
+        return (0u);
+    }
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    CANOS_SrvSem.Ctr = 0u;                            /* consume all further indications               */
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
+    return (1u);                                      /* return function result                        */
+}
+
+
+/*
+*********************************************************************************************************
+*                                        CANOS_PostRxService()
+*
+* Description : This function shall indicate staged CAN frames to the receive service task.
+*
+* Argument(s) : None.
+*
+* Return(s)   : None.
+*
+* Note(s)     : This function is a wrapper around the wanted operating system. The following
+*               implementation is an implementation for uC/OS-III.
+*********************************************************************************************************
+*/
+
+void  CANOS_PostRxService (void)
+{
+    CPU_INT16U  err;                                  /* Local: OS error code                          */
+
+
+    OSSemPost (&CANOS_SrvSem,                         /* signal staged frames                          */
+               OS_OPT_POST_1,
+               &err);
+    if (err != CAN_ERR_NONE) {                        /* see, if no error is detected                  */
+        can_errnum = CAN_ERR_OSSEMPOST;               /* set error indication                          */
+    }
+}
+#endif                                                /* CANBUS_RX_DEFER_EN > 0                        */
+
+
 /*
 *********************************************************************************************************
 *                                           CANOS_GetTime()
@@ -372,6 +980,35 @@ CPU_INT32U  CANOS_GetTime (void)
 }
 
 
+/*
+*********************************************************************************************************
+*                                         CANOS_GetTimestamp()
+*
+* Description : This function shall receive a high resolution timestamp for received CAN frames. The
+*               free running 32 bit timestamp of uC/CPU is used, when it is enabled. Otherwise the
+*               time of the OS is used (see CANOS_GetTime()).
+*
+* Argument(s) : None.
+*
+* Return(s)   : 32 bit value that represent the timestamp.
+*
+* Note(s)     : This function is a wrapper around the wanted operating system. The following
+*               implementation is an implementation for uC/OS-III.
+*********************************************************************************************************
+*/
+
+#if CANFRM_TIMESTAMP_EN > 0
+CPU_INT32U  CANOS_GetTimestamp (void)
+{
+#if (CPU_CFG_TS_32_EN == DEF_ENABLED)
+    return ((CPU_INT32U)CPU_TS_Get32());              /* free running timestamp of uC/CPU              */
+#else
+    return (CANOS_GetTime());                         /* fallback: time in resolution of the OS        */
+#endif
+}
+#endif                                                /* CANFRM_TIMESTAMP_EN > 0                       */
+
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
@@ -53,6 +53,17 @@ extern "C" {
 #define CANOS_NO_ERR      (CPU_INT08U)0
 
 
+/*-----------------------------------------------------------------------------------------------------*/
+/*! \brief                                OS: TIME RESOLUTION
+*
+*            This define holds the number of time units per second of CANOS_GetTime().
+*            The time of uC/OS-III is counted in OS ticks.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+#define CANOS_TICK_RATE_HZ  OSCfg_TickRate_Hz
+
+
 /*
 *********************************************************************************************************
 *                                       FUNCTION PROTOTYPES
@@ -64,19 +75,62 @@ CPU_INT16S  CANOS_Init       (void);
 CPU_INT08U  CANOS_PendRxFrame(CPU_INT16U  timeout,
                               CPU_INT16S  busId);
 
+CPU_INT16U  CANOS_PendRxFrameN(CPU_INT16U  timeout,
+                               CPU_INT16S  busId,
+                               CPU_INT16U  max);
+
 void        CANOS_PostRxFrame(CPU_INT16S  busId);
 
+void        CANOS_PostRxFrameN(CPU_INT16S  busId,
+                               CPU_INT16U  num);
+
 void        CANOS_ResetRx    (CPU_INT16S  busId);
 
 CPU_INT08U  CANOS_PendTxFrame(CPU_INT16U  timeout,
                               CPU_INT16S  busId);
 
+CPU_INT16U  CANOS_PendTxFrameN(CPU_INT16U  timeout,
+                               CPU_INT16S  busId,
+                               CPU_INT16U  max);
+
 void        CANOS_PostTxFrame(CPU_INT16S  busId);
 
-void        CANOS_ResetTx    (CPU_INT16S  busId);
+void        CANOS_PostTxFrameN(CPU_INT16S  busId,
+                               CPU_INT16U  num);
+
+void        CANOS_ResetTx    (CPU_INT16S  busId,
+                              CPU_INT16U  size);
+
+#if CANBUS_SUB_EN > 0
+CPU_INT08U  CANOS_PendSubFrame(CPU_INT16U  timeout,
+                               CPU_INT16S  subId);
+
+void        CANOS_PostSubFrame(CPU_INT16S  subId);
+
+void        CANOS_ResetSub   (CPU_INT16S  subId);
+#endif
+
+#if CANBUS_WAIT_EN > 0
+void        CANOS_PostRxFlag (CPU_INT16S  busId);
+
+void        CANOS_ClrRxFlags (CPU_INT32U  mask);
+
+CPU_INT32U  CANOS_PendRxFlags(CPU_INT16U  timeout,
+                              CPU_INT32U  mask);
+#endif
+
+#if CANBUS_RX_DEFER_EN > 0
+CPU_INT08U  CANOS_PendRxService(CPU_INT16U  timeout);
+
+void        CANOS_PostRxService(void);
+#endif
 
 CPU_INT32U  CANOS_GetTime    (void);
 
+#if CANFRM_TIMESTAMP_EN > 0
+CPU_INT32U  CANOS_GetTimestamp(void);
+#endif
+
 
 #ifdef __cplusplus
 }
@@ -33,6 +33,37 @@
 #include  "can_bus.h"                                 /* can bus handling functions                    */
 #include  "can_frm.h"                                 /* can frame definitions                         */
 #include  "can_err.h"                                 /* can error codes                               */
+#if CANBUS_RX_MSG_EN > 0
+#include  "can_msg.h"                                 /* can message handling functions                */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#if  (CANBUS_EN > 0) && (CANBUS_WAIT_EN > 0) && (CANBUS_N >= 32u)
+#define  CANBUS_ALL_MASK  0xFFFFFFFFuL                       /* bitmask of all busses                 */
+#elif (CANBUS_EN > 0) && (CANBUS_WAIT_EN > 0)
+#define  CANBUS_ALL_MASK  ((1uL << CANBUS_N) - 1uL)          /* bitmask of all busses                 */
+#endif
+
+#if  (CANBUS_EN > 0) && (CANBUS_TX_PRIO_EN > 0)
+#define  CANBUS_TX_HEAD(bus, rd)  (&(bus)->BufTx[0])         /* highest priority frame (heap root)    */
+#elif CANBUS_EN > 0
+#define  CANBUS_TX_HEAD(bus, rd)  (&(bus)->BufTx[(rd) & (bus)->TxMask]) /* oldest frame            */
+#endif
+
+#if  (CANBUS_EN > 0) && (CANBUS_TX_CONFIRM_EN > 0)
+#define  CANBUS_TX_TAG(frm)       ((frm)->Spare[0])          /* confirmation tag of queued frame      */
+#define  CANBUS_TX_SENT_FULL(bus) ((bus)->TxSentWr != (bus)->TxSentRd) /* frame in device             */
+#endif
+
+#if  CANBUS_EN > 0
+#define  CANBUS_NUM_MAX           0x7FFFu                    /* max. number of frames in a result     */
+#endif
 
 
 /*
@@ -53,8 +84,26 @@ volatile  CPU_INT16S  can_errnum = CAN_ERR_NONE;      /* latest CAN error code
 
         CANBUS_DATA  CanBusTbl[CANBUS_N];
 
+#if CANBUS_SUB_EN > 0
+        CANBUS_SUB   CanBusSubTbl[CANBUS_SUB_N];      /* receive subscribers of all busses             */
+#endif
+
+#if CANBUS_GW_EN > 0
+        CANBUS_GW    CanBusGwTbl[CANBUS_GW_N];        /* gateway routes of all busses                  */
+#endif
+
 static  CPU_INT08U   CanBus_IsInitialized = 0u;       /* marker for: CanBus module is initialized      */
 
+#if CANBUS_RX_QSIZE > 0                               /* default storage of receive frame buffers      */
+static  CANFRM       CanBusRxStore[CANBUS_N][CANBUS_RX_QSIZE];
+#endif
+#if CANBUS_TX_QSIZE > 0                               /* default storage of transmit frame buffers     */
+static  CANFRM       CanBusTxStore[CANBUS_N][CANBUS_TX_QSIZE];
+#if CANBUS_TX_PRIO_EN > 0
+static  CPU_INT16U   CanBusTxSeqStore[CANBUS_N][CANBUS_TX_QSIZE];
+#endif
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -66,6 +115,132 @@ static  void  CanBusCpy(void        *dst,
                         void        *src,
                         CPU_INT08U   size);
 
+static  CPU_INT16S  CanBusQueueInit(CANBUS_DATA  *bus,
+                                    CANBUS_PARA  *cfg);
+
+#if CANBUS_STAT_EN > 0
+static  CPU_INT16U  CanBusFrmBits(CANFRM       *frm);
+
+static  void        CanBusStatGet(CANBUS_DATA  *bus,
+                                  CANBUS_STAT  *stat);
+#endif
+
+#if (CANBUS_STAT_EN > 0) && ((CANBUS_TX_HANDLER_EN > 0) || (CANBUS_RX_HANDLER_EN > 0))
+static  void        CanBusStatHwm(CPU_INT16U   *hwm,
+                                  CPU_INT16U    used);
+#endif
+
+static  CPU_BOOLEAN CanBusTxReady(CANBUS_DATA  *bus);
+
+#if CANBUS_TX_HANDLER_EN > 0
+static  CPU_INT16U  CanBusTxStart(CANBUS_DATA  *bus);
+#endif
+
+#if CANBUS_RX_HANDLER_EN > 0
+static  CPU_INT16S   CanBusRxProcess(CPU_INT16S    busId,
+                                     CANBUS_DATA  *bus,
+                                     CANFRM       *frm);
+#endif
+
+#if CANBUS_RX_HANDLER_EN > 0
+static  void         CanBusRxPost   (CPU_INT16S    busId,
+                                     CANBUS_DATA  *bus,
+                                     CPU_INT16U    num);
+
+static  void         CanBusRxPublish(CPU_INT16S    busId,
+                                     CANBUS_DATA  *bus,
+                                     CPU_INT16U    wr);
+#endif
+
+#if CANBUS_RX_COALESCE_EN > 0
+static  void         CanBusRxFlush  (CPU_INT16S    busId,
+                                     CANBUS_DATA  *bus);
+#endif
+
+#if CANBUS_RX_POLICY_EN > 0
+static  void         CanBusRxShed   (CPU_INT16S    busId,
+                                     CANBUS_DATA  *bus,
+                                     CANFRM       *frm);
+#endif
+
+#if CANBUS_RX_POLL_EN > 0
+static  void         CanBusRxMode   (CANBUS_DATA  *bus);
+#endif
+
+#if CANBUS_RX_HANDLER_EN > 0
+static  CPU_INT16S   CanBusRxRead   (CANBUS_DATA  *bus,
+                                     CANFRM       *frm);
+#endif
+
+#if (CANBUS_RX_HANDLER_EN > 0) && (CANBUS_RX_DEFER_EN == 0)
+static  CPU_BOOLEAN  CanBusRxBurst  (CPU_INT16S    busId,
+                                     CANBUS_DATA  *bus);
+#endif
+
+#if CANBUS_RX_DEFER_EN > 0
+static  void         CanBusRxStage  (CPU_INT16S    busId,
+                                     CANBUS_DATA  *bus);
+
+static  CPU_INT16U   CanBusRxDrain  (CPU_INT16S    busId,
+                                     CANBUS_DATA  *bus);
+#endif
+
+#if (CANBUS_SUB_EN > 0) && (CANBUS_RX_HANDLER_EN > 0)
+static  CPU_INT16S  CanBusSubRoute(CPU_INT16S    busId,
+                                   CANFRM       *frm);
+#endif
+
+#if CANBUS_GW_EN > 0
+static  CPU_INT16S   CanBusGwRoute (CPU_INT16S    busId,
+                                    CANBUS_DATA  *bus,
+                                    CANFRM       *frm);
+
+static  void         CanBusGwSend  (CANBUS_DATA  *dst,
+                                    CANFRM       *frm);
+
+static  CPU_BOOLEAN  CanBusGwStart (CANBUS_DATA  *bus);
+#endif
+
+#if CANBUS_FILTER_EN > 0
+static  void         CanBusFilterClear (CANBUS_DATA  *bus);
+
+#if CANBUS_RX_HANDLER_EN > 0
+static  CPU_BOOLEAN  CanBusFilterAccept(CANBUS_DATA  *bus,
+                                        CPU_INT32U    identifier);
+#endif
+
+static  CPU_INT16S   CanBusFilterSet   (CANBUS_DATA  *bus,
+                                        CPU_INT32U    identifier,
+                                        CPU_BOOLEAN   accept);
+#endif
+
+#if ((CANBUS_TX_HANDLER_EN > 0) && (CANBUS_TX_PRIO_EN > 0)) || (CANBUS_RX_POLICY_EN > 0)
+static  CPU_INT32U  CanBusTxKey  (CPU_INT32U    identifier);
+#endif
+
+#if (CANBUS_TX_HANDLER_EN > 0) && (CANBUS_TX_PRIO_EN > 0)
+static  void        CanBusTxPush (CANBUS_DATA  *bus,
+                                  CANFRM       *frm,
+                                  CPU_INT08U    tag);
+
+static  void        CanBusTxPop  (CANBUS_DATA  *bus);
+#endif
+
+#if CANBUS_TX_CONFIRM_EN > 0
+static  void        CanBusTxSent   (CANBUS_DATA  *bus,
+                                    CPU_INT08U    tag);
+
+static  void        CanBusTxConfirm(CPU_INT16S    busId,
+                                    CANBUS_DATA  *bus);
+
+static  void        CanBusTxFail   (CANBUS_DATA  *bus,
+                                    CPU_INT08U    tag);
+
+static  void        CanBusTxAbort  (CPU_INT16S    busId,
+                                    CANBUS_DATA  *bus,
+                                    CPU_BOOLEAN   sent);
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -110,254 +285,3363 @@ static  void  CanBusCpy (void        *dst,
 
 /*
 *********************************************************************************************************
-*                                            CanBusInit()
+*                                          CanBusQueueInit()
 *
-* Description : Initializes the CAN bus management. This includes the creation of all needed OS-service
-*               components. The needed components are dependened on the configuration of the CAN bus 
-*               management mode.
+* Description : Links the receive and transmit frame buffers to the bus and resets the queues. The
+*               buffers are taken from the bus configuration, or from the default storage if the
+*               configuration provides no buffer.
 *
-* Argument(s) : arg     Not used
+* Argument(s) : bus     Pointer to bus data
 *
-* Return(s)   : Errorcode, if an error is detected, otherwise CAN_ERR_NONE for successful initialization.
+*               cfg     Pointer to bus configuration
 *
-* Note(s)     : This function has the standard device driver interface, decribed in the porting chapter
-*               of the user manual. This allows the CAN bus handling via the standard device driver
-*               interface.
+* Return(s)   : Errorcode CAN_ERR_BUFFSIZE, if a queue size is no power of 2 or no storage is
+*               available, otherwise CAN_ERR_NONE.
+*
+* Note(s)     : This function must be called while the bus is disabled.
 *********************************************************************************************************
 */
 
-CPU_INT16S  CanBusInit (CPU_INT32U  arg)
+static  CPU_INT16S  CanBusQueueInit (CANBUS_DATA  *bus,
+                                     CANBUS_PARA  *cfg)
 {
-    CANBUS_DATA  *bus    = &(CanBusTbl[0]);           /* Local: pointer to bus #1                      */
-    CPU_INT32U    i;                                  /* Local: loop variable                          */
-    CPU_INT16S    err;                                /* Local: errorcode of CANOS initialization      */
-    CPU_INT16S    result = CAN_ERR_NONE;              /* Local: function result                        */
+    CPU_INT16S  busId = (CPU_INT16S)cfg->BusNodeName; /* Local: bus identifier                         */
+    CANFRM     *rxbuf;                                /* Local: receive frame buffer                   */
+    CANFRM     *txbuf;                                /* Local: transmit frame buffer                  */
+    CPU_INT16U  rxsize;                               /* Local: receive queue size                     */
+    CPU_INT16U  txsize;                               /* Local: transmit queue size                    */
+#if CANBUS_TX_PRIO_EN > 0
+    CPU_INT16U *txseq;                                /* Local: transmit heap sequence numbers         */
+#endif
+#if CANBUS_TX_CONFIRM_EN > 0
+    CPU_INT16U  i;                                    /* Local: loop variable                          */
+#endif
 
 
-   (void)arg;                                         /* unused; prevent compiler warning              */
+    if (cfg->RxBuf != NULL_PTR) {                     /* see, if receive storage is provided           */
+        rxbuf  = cfg->RxBuf;
+        rxsize = cfg->RxQSize;
+    } else {                                          /* otherwise: use default storage                */
+#if CANBUS_RX_QSIZE > 0
+        rxbuf  = &CanBusRxStore[busId][0];
+        rxsize = CANBUS_RX_QSIZE;
+#else
+        rxbuf  = (CANFRM *)0;
+        rxsize = 0u;
+#endif
+    }
+    if (cfg->TxBuf != NULL_PTR) {                     /* see, if transmit storage is provided          */
+        txbuf  = cfg->TxBuf;
+        txsize = cfg->TxQSize;
+#if CANBUS_TX_PRIO_EN > 0
+        txseq  = cfg->TxSeqBuf;
+        if (txseq == NULL_PTR) {                      /* heap needs sequence storage, too              */
+            txsize = 0u;
+        }
+#endif
+    } else {                                          /* otherwise: use default storage                */
+#if CANBUS_TX_QSIZE > 0
+        txbuf  = &CanBusTxStore[busId][0];
+        txsize = CANBUS_TX_QSIZE;
+#if CANBUS_TX_PRIO_EN > 0
+        txseq  = &CanBusTxSeqStore[busId][0];
+#endif
+#else
+        txbuf  = (CANFRM *)0;
+        txsize = 0u;
+#if CANBUS_TX_PRIO_EN > 0
+        txseq  = (CPU_INT16U *)0;
+#endif
+#endif
+    }
+    if ((rxsize == 0u) || ((rxsize & (rxsize - 1u)) != 0u) ||
+        (txsize == 0u) || ((txsize & (txsize - 1u)) != 0u)) {
+        return CAN_ERR_BUFFSIZE;                      /* queue size is no power of 2                   */
+    }
+
+    bus->BufRx      = rxbuf;                          /* link receive frame buffer                     */
+    bus->RxMask     = rxsize - 1u;
+    bus->BufRxRd    = 0u;
+    bus->BufRxWr    = 0u;
+    bus->RxPeek     = 0u;
+#if CANBUS_RX_COALESCE_EN > 0
+    bus->RxUnposted = 0u;                             /* no coalesced frames                           */
+#endif
+#if CANBUS_RX_DEFER_EN > 0
+    bus->StageRd    = 0u;                             /* staging ring is empty                         */
+    bus->StageWr    = 0u;
+#endif
+#if CANBUS_RX_POLL_EN > 0
+    bus->RxPolling  = CAN_FALSE;                      /* opened device uses the receive interrupt      */
+    bus->RxPollCnt  = 0u;
+    bus->RxPollTime = CANOS_GetTime();
+#endif
+    bus->BufTx      = txbuf;                          /* link transmit frame buffer                    */
+    bus->TxMask     = txsize - 1u;
+    bus->BufTxRd    = 0u;
+    bus->BufTxWr    = 0u;
+    bus->TxReserved = 0u;
+#if CANBUS_GW_EN > 0
+    bus->GwRd       = 0u;                             /* no forwarded frames                           */
+    bus->GwWr       = 0u;
+#endif
+#if CANBUS_TX_CONFIRM_EN > 0
+    for (i = 0u; i < CANBUS_TX_CONFIRM_N; i++) {      /* no unconfirmed frames                         */
+        bus->TxCbFunc[i] = NULL_PTR;
+    }
+    bus->TxSentRd   = 0u;
+    bus->TxSentWr   = 0u;
+#endif
+#if CANBUS_TX_PRIO_EN > 0
+    bus->BufTxSeq   = txseq;
+    bus->TxSeq      = 0u;
+    bus->TxResBase  = 0u;
+#endif
+    CANOS_ResetRx(busId);                             /* reset counting semaphores to the queue sizes  */
+    CANOS_ResetTx(busId, txsize);
+
+    return CAN_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusFrmBits()
+*
+* Description : Calculates the number of bits, which are needed to transfer the CAN frame on the bus.
+*               Auxillary routine for the bus load statistics.
+*
+* Argument(s) : frm     Pointer to CAN frame
+*
+* Return(s)   : Number of bits of the CAN frame with worst case bit stuffing.
+*
+* Note(s)     : The frame length is: g + 8n + 13 + (g + 8n - 1) / 4, with n data bytes and g = 34 bits
+*               (standard identifier) or g = 54 bits (extended identifier) of the control fields, which
+*               are subject to bit stuffing. The 13 bits are the CRC delimiter, acknowledge field, end
+*               of frame and interframe space.
+*********************************************************************************************************
+*/
 
-    if (CanBus_IsInitialized == 0u) {
-        err = CANOS_Init();                           /* Initialize OS specific services               */
-        if (err != CAN_ERR_NONE) {                    /* See, if services are initialized              */
-            can_errnum = err;
-            return err;                               /* set function result to 'error'                */
-        } else {                                      /* otherwise, build free list:                   */
-            for (i=0u; i<CANBUS_N; i++) {             /* loop through all CAN busses in table          */
-                bus->RxTimeout = 0u;                  /* set timeout to 0 (Rx in blocking mode)        */
-                bus->TxTimeout = 0u;                  /* set timeout to 0 (Tx in blocking mode)        */
-                bus->Dev       = 0;                   /* clear device identifier                       */
-                bus->Cfg       = NULL_PTR;            /* clear pointer to bus configuration            */
-                bus->BufRxRd   = 0u;                  /* set receive read location to buffer           */
-                bus->BufRxWr   = 0u;                  /* set receive write location to buffer          */
-                bus->BufTxRd   = 0u;                  /* set transmit read location to buffer          */
-                bus->BufTxWr   = 0u;                  /* set transmit write location to buffer         */
 #if CANBUS_STAT_EN > 0
-                bus->RxLost    = 0u;                  /* clear counter for lost RX frames              */
-                bus->TxLost    = 0u;                  /* clear counter for lost TX frames              */
-                bus->RxOk      = 0u;                  /* clear counter for received RX frames          */
-                bus->TxOk      = 0u;                  /* clear counter for transmitted TX frames       */
-#endif                                                /* CANBUS_STAT_EN > 0 */
+static  CPU_INT16U  CanBusFrmBits (CANFRM  *frm)
+{
+    CPU_INT16U  bits;                                 /* Local: bits, which are subject to bit stuffing*/
 
-                bus++;                                /* lint !e960 switch bus to next bus in table    */
-            }
-            CanBus_IsInitialized = 1u;                /* mark bus initialized                          */
+
+    if ((frm->Identifier & CANFRM_EXT_FLAG) != 0u) {  /* see, if frame has an extended identifier      */
+        bits = 54u;
+    } else {
+        bits = 34u;
+    }
+    if ((frm->Identifier & CANFRM_RTR_FLAG) == 0u) {  /* see, if frame is a data frame                 */
+        if (frm->DLC < 8u) {                          /* yes: add payload (limited to 8 bytes)         */
+            bits += (CPU_INT16U)(8u * frm->DLC);
+        } else {
+            bits += 64u;
         }
     }
 
-    return result;                                    /* return function result                        */
+    return ((CPU_INT16U)(bits + 13u + ((bits - 1u) / 4u)));
 }
+#endif                                                /* CANBUS_STAT_EN > 0                            */
 
 
 /*
 *********************************************************************************************************
-*                                            CanBusIoCtl()
+*                                           CanBusStatHwm()
 *
-* Description : This function performs a special action on the opened device. The function code func 
-*               defines what the caller wants to do.
+* Description : Updates a queue high-water mark. Auxillary routine for the bus statistics.
 *
-* Argument(s) : busId   Bus identifier
+* Argument(s) : hwm     Pointer to high-water mark
 *
-*               func    function code
+*               used    Number of used queue entries
 *
-*                           CANBUS_RESET             Reinitialize the CAN bus; all pending transmissions
-*                                                    will be canceled and received messages will be lost.
+* Return(s)   : none.
 *
-*                           CANBUS_FLUSH_TX          Remove all entries out of the TX queue
+* Note(s)     : The high-water mark must be written by the queue producer only.
+*********************************************************************************************************
+*/
+
+#if (CANBUS_STAT_EN > 0) && ((CANBUS_TX_HANDLER_EN > 0) || (CANBUS_RX_HANDLER_EN > 0))
+static  void  CanBusStatHwm (CPU_INT16U  *hwm,
+                             CPU_INT16U   used)
+{
+    if (used > *hwm) {                                /* see, if new maximum is reached                */
+        *hwm = used;                                  /* yes: remember maximum                         */
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusStatGet()
 *
-*                           CANBUS_FLUSH_RX          Remove all entries out of the RX queue
+* Description : Takes a snapshot of the bus statistics and calculates the bus load since the previous
+*               snapshot. Auxillary routine for CanBusIoCtl().
 *
-*                           CANBUS_SET_TX_TIMEOUT    Set TX timeout value
+* Argument(s) : bus     Pointer to bus data
 *
-*                           CANBUS_SET_RX_TIMEOUT    Set RX timeout value
+*               stat    Pointer to statistics snapshot
 *
-*               argp    Pointer to argument, specific to the function code
+* Return(s)   : none.
 *
-* Return(s)   : Errorcode, if an error is detected, otherwise CAN_ERR_NONE for successful operation.
+* Note(s)     : The bus load is the sum of the received and transmitted bus bits (see CanBusFrmBits())
+*               relative to the number of bits, which can be transferred with the configured baudrate
+*               within the measurement time.
+*********************************************************************************************************
+*/
+
+#if CANBUS_STAT_EN > 0
+static  void  CanBusStatGet (CANBUS_DATA  *bus,
+                             CANBUS_STAT  *stat)
+{
+    CPU_INT32U  now;                                  /* Local: current time                           */
+    CPU_INT32U  bits;                                 /* Local: sum of received and transmitted bits   */
+    CPU_INT64U  cap;                                  /* Local: bus capacity * CANOS_TICK_RATE_HZ      */
+    CPU_INT64U  load;                                 /* Local: bus load in percent                    */
+    CPU_SR_ALLOC();                                   /* Local: Storage for CPU status register        */
+
+
+    now = CANOS_GetTime();                            /* get end of measurement time                   */
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    stat->RxOk   = bus->RxOk;                         /* copy consistent set of counters               */
+    stat->TxOk   = bus->TxOk;
+    stat->RxLost = bus->RxLost;
+    stat->TxLost = bus->TxLost;
+    stat->RxErr  = bus->RxErr;
+    stat->TxErr  = bus->TxErr;
+    stat->RxHwm  = bus->RxHwm;
+    stat->TxHwm  = bus->TxHwm;
+#if CANBUS_RX_POLICY_EN > 0
+    stat->RxDropNewest = bus->RxDropNewest;
+    stat->RxDropOldest = bus->RxDropOldest;
+    stat->RxEvicted    = bus->RxEvicted;
+#endif
+#if CANBUS_RX_POLL_EN > 0
+    stat->RxPollEnter  = bus->RxPollEnter;
+    stat->RxPollLeave  = bus->RxPollLeave;
+#endif
+#if CANBUS_GW_EN > 0
+    stat->GwFwd        = bus->GwFwd;
+    stat->GwLost       = bus->GwLost;
+    stat->GwDlcErr     = bus->GwDlcErr;
+#endif
+    bits         = bus->RxBits + bus->TxBits;
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
+
+    cap  = (CPU_INT64U)bus->Cfg->Baudrate * (CPU_INT32U)(now - bus->LoadTime);
+    load = 0u;
+    if (cap > 0u) {                                   /* see, if measurement time is elapsed           */
+        load = ((CPU_INT64U)(CPU_INT32U)(bits - bus->LoadBits) * 100u * CANOS_TICK_RATE_HZ) / cap;
+        if (load > 100u) {                            /* limit estimation to 100 percent               */
+            load = 100u;
+        }
+    }
+    stat->Load    = (CPU_INT08U)load;
+    bus->LoadTime = now;                              /* start next measurement                        */
+    bus->LoadBits = bits;
+}
+#endif                                                /* CANBUS_STAT_EN > 0                            */
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusTxReady()
 *
-* Note(s)     : This function has the standard device driver interface, decribed in the porting chapter
-*               of the user manual. This allows the CAN bus handling via the standard device driver
-*               interface.
+* Description : Checks, if the CAN bus device can accept a frame for transmission.
+*
+* Argument(s) : bus     Pointer to bus data
+*
+* Return(s)   : CAN_TRUE, if the device is ready for transmission, otherwise CAN_FALSE.
+*
+* Note(s)     : The status is read with the transmit ready function of the driver (CANBUS_PARA.TxReady).
+*               Without this function, the status is requested with the IoCtl function code
+*               CAN_TX_READY.
 *********************************************************************************************************
 */
 
-CPU_INT16S  CanBusIoCtl (CPU_INT16S   busId,
-                         CPU_INT16U   func,
-                         void        *argp)
+static  CPU_BOOLEAN  CanBusTxReady (CANBUS_DATA  *bus)
 {
-    CPU_INT16S    result = CAN_ERR_UNKNOWN;           /* Local: function result                        */
-    CANBUS_DATA  *bus;                                /* Local: pointer to bus data                    */
-    CANBUS_PARA  *cfg;                                /* Local: pointer to bus configuration           */
-    CPU_INT16U    drvfunc;                            /* Local: translated driver function code        */
-    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+    CANBUS_PARA  *cfg = bus->Cfg;                     /* Local: pointer to bus configuration           */
+    CPU_INT16S    err;                                /* Local: errorcode of device driver             */
+    CPU_INT08U    txstatus;                           /* Local: Status of device tx buffer             */
 
 
-#if CANBUS_ARG_CHK_EN > 0
-                                                      /* is busId out of range?                        */
-    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) {
-        can_errnum = CAN_ERR_BUSID;
-        return CAN_ERR_BUSID;
+    if (cfg->TxReady != NULL_PTR) {                   /* see, if driver provides the status directly   */
+        err = cfg->TxReady(bus->Dev);
+        if (err > 0) {
+            return (CAN_TRUE);
+        }
+        CANSetErrRegister(err);
+        return (CAN_FALSE);
     }
-    if (CanBusTbl[busId].Cfg == NULL_PTR) {           /* is bus not enabled?                           */
-        can_errnum = CAN_ERR_NULLPTR;
-        return CAN_ERR_NULLPTR;
+    err = cfg->IoCtl(bus->Dev,                        /* get CAN bus device tx buffer status           */
+                     cfg->Io[CAN_TX_READY],
+                     (void*)&txstatus);
+    CANSetErrRegister(err);
+    if ((err != CAN_ERR_NONE) ||                      /* see, if device is not ready                   */
+        (txstatus != (CPU_INT08U)CAN_TRUE)) {         /*lint !e644 txstatus set by IoCtl               */
+        return (CAN_FALSE);
     }
-#endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
+    return (CAN_TRUE);
+}
 
-    bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
-    cfg = bus->Cfg;                                   /* yes: set pointer to bus configuration         */
 
-    switch (func) {                                   /* Switch to selected function code              */
-                                                      /*-----------------------------------------------*/
-        case CANBUS_RESET:                            /*                 Reset CAN bus                 */
-                                                      /*-----------------------------------------------*/
-            result = cfg->Close(bus->Dev);            /* Close opened CAN bus                          */
-            if (result != CAN_ERR_NONE) {
-                break;
-            }
-            result = cfg->Init(cfg->DriverDevName);   /* Reinitialize the CAN bus                      */
-            if (result != CAN_ERR_NONE) {
-                break;
-            }
-                                                      /* Open configured can bus                       */
-            bus->Dev = cfg->Open((CPU_INT16S)cfg->BusNodeName,
-                                 cfg->DriverDevName,
-                                 DEV_RW);
-            if (bus->Dev >= 0) {                      /* See, if bus can be opened                     */
-                drvfunc = cfg->Io[CAN_SET_BAUDRATE];
-                result = cfg->IoCtl(bus->Dev, drvfunc,/* Set can bus timing with:                      */
-                           (void*)&(cfg->Baudrate));  /*   configured baudrate                         */
-                if (result != CAN_ERR_NONE) {
-                    break;
-                }
-                                                      /* see, if Ext.Ids on receiver are enabled       */
-                if (cfg->Extended == CAN_TRUE) {
-                    result = cfg->IoCtl(bus->Dev,     /* Set receiver to extended format ids           */
-                                     cfg->Io[CAN_RX_EXTENDED],
-                                     0);
-                    if (result != CAN_ERR_NONE) {
-                        break;
-                    }
-                }
-                result = cfg->IoCtl(bus->Dev,         /* Enable can bus communication                  */
-                                 cfg->Io[CAN_START], 0);
-                if (result != CAN_ERR_NONE) {
-                    break;
-                }
-                result = CAN_ERR_NONE;                /* successfull can bus initialisation            */
-            }
-            else {
-                result = CAN_ERR_OPEN;
-            }
-            break;
+/*
+*********************************************************************************************************
+*                                           CanBusTxStart()
+*
+* Description : Write queued frames out of the transmit buffer to the CAN bus device, as long as the
+*               device is ready to transmit. Auxillary routine for the transmit functions.
+*
+* Argument(s) : bus     Pointer to bus data
+*
+* Return(s)   : Number of frames, which are removed from the transmit buffer.
+*
+* Note(s)     : This function must be called with enabled interrupts. Each frame is written within its
+*               own critical section, so the interrupt lock time is limited to a single driver write and
+*               the bookkeeping of this frame, and the TX-ISR and the writers can share the refill.
+*
+*               A frame, which is rejected by the device, is dropped (and counted as driver error), so
+*               a single driver error can't stall the transmit buffer.
+*********************************************************************************************************
+*/
 
-                                                      /*-----------------------------------------------*/
-        case CANBUS_FLUSH_TX:                         /*                Flush tx queue                 */
-                                                      /*-----------------------------------------------*/
-            CPU_CRITICAL_ENTER();                     /* disable all interrupts                        */
-            bus->BufTxRd = bus->BufTxWr;              /* buffer is empty when read = write ptr         */
-            CANOS_ResetTx(busId);
-            CPU_CRITICAL_EXIT();                      /* enable all interrupts                         */
-            result       = CAN_ERR_NONE;              /* indicate successful operation                 */
-            break;
+#if CANBUS_TX_HANDLER_EN > 0
+static  CPU_INT16U  CanBusTxStart (CANBUS_DATA  *bus)
+{
+    CANBUS_PARA  *cfg = bus->Cfg;                     /* Local: pointer to bus configuration           */
+    CPU_INT16S    err;                                /* Local: errorcode of device driver             */
+    CPU_INT16U    rd;                                 /* Local: transmit buffer read counter           */
+    CPU_INT16U    num = 0u;                           /* Local: number of written frames               */
+    CANFRM       *frm;                                /* Local: pointer to next queued frame           */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
 
-                                                      /*-----------------------------------------------*/
-        case CANBUS_FLUSH_RX:                         /*                Flush rx queue                 */
-                                                      /*-----------------------------------------------*/
-            CPU_CRITICAL_ENTER();                     /* disable all interrupts                        */
-            bus->BufRxRd = bus->BufRxWr;              /* buffer is empty when read = write ptr         */
-            CANOS_ResetRx(busId);
-            CPU_CRITICAL_EXIT();                      /* enable all interrupts                         */
-            result       = CAN_ERR_NONE;              /* indicate successful operation                 */
+
+    for (;;) {                                        /* loop through all queued frames                */
+        CPU_CRITICAL_ENTER();                         /* one critical section per frame                */
+        rd = bus->BufTxRd;
+        if (rd == bus->BufTxWr) {                     /* see, if no further frame is queued            */
             break;
+        }
+#if CANBUS_TX_CONFIRM_EN > 0
+        if (CANBUS_TX_SENT_FULL(bus)) {               /* see, if a frame waits for confirmation        */
+            break;                                    /* yes: remaining frames are sent by TX-ISR      */
+        }
+#endif
+        if (CanBusTxReady(bus) == CAN_FALSE) {        /* see, if device is not ready                   */
+            break;                                    /* yes: remaining frames are sent by TX-ISR      */
+        }
+        CANBUS_MB();                                  /* read entry after published write counter      */
+        frm = CANBUS_TX_HEAD(bus, rd);
+        err = cfg->Write(bus->Dev, (void *)frm,       /* write can frame to can bus interface          */
+                         CANFRM_DRV_SIZE);
+        if (err == (CPU_INT16S)CANFRM_DRV_SIZE) {     /* see, if frame is accepted by the device       */
+#if CANBUS_STAT_EN > 0
+            bus->TxOk++;                              /* increment transmission counter                */
+            bus->TxBits += CanBusFrmBits(frm);        /* add frame to transmitted bus bits             */
+#endif
+#if CANBUS_TX_CONFIRM_EN > 0
+            CanBusTxSent(bus, CANBUS_TX_TAG(frm));    /* frame waits for confirmation                  */
+#endif
+        } else {                                      /* otherwise: drop the rejected frame            */
+            CANSetErrRegister(err);
+#if CANBUS_STAT_EN > 0
+            bus->TxErr++;                             /* increment driver error counter                */
+#endif
+#if CANBUS_TX_CONFIRM_EN > 0
+            CanBusTxFail(bus, CANBUS_TX_TAG(frm));    /* confirm dropped frame with an error           */
+#endif
+        }
+#if CANBUS_TX_PRIO_EN > 0
+        CanBusTxPop(bus);                             /* remove frame from transmit heap               */
+#endif
+        CANBUS_MB();                                  /* complete write before releasing the entry     */
+        bus->BufTxRd = rd + 1u;                       /* release entry of removed frame                */
+        CPU_CRITICAL_EXIT();
+        num++;
+    }
+    CPU_CRITICAL_EXIT();                              /* leave critical section of the last check      */
+
+    return (num);                                     /* return number of removed frames               */
+}
+#endif                                                /* CANBUS_TX_HANDLER_EN > 0                      */
+
+
+/*
+*********************************************************************************************************
+*                                            CanBusTxKey()
+*
+* Description : Calculates the arbitration key of a CAN identifier. A lower key wins the bus arbitration.
+*               The key orders the base identifier first, followed by the RTR/SRR bit, the IDE bit,
+*               the identifier extension and the RTR bit of extended frames.
+*
+* Argument(s) : identifier   The identifier of the CAN frame, including RTR and EXT flag
+*
+* Return(s)   : The arbitration key of the identifier.
+*
+* Note(s)     : -
+*********************************************************************************************************
+*/
+
+#if ((CANBUS_TX_HANDLER_EN > 0) && (CANBUS_TX_PRIO_EN > 0)) || (CANBUS_RX_POLICY_EN > 0)
+static  CPU_INT32U  CanBusTxKey (CPU_INT32U  identifier)
+{
+    CPU_INT32U  key;                                  /* Local: arbitration key                        */
+
+
+    if ((identifier & CANFRM_EXT_FLAG) != 0u) {       /* see, if identifier is extended                */
+        key = (((identifier >> 18u) & CANFRM_STD_ID_MSK) << 21u) |
+              (1uL << 20u) |                          /* SRR bit (always recessive)                    */
+              (1uL << 19u) |                          /* IDE bit (recessive)                           */
+              ((identifier & 0x3FFFFuL) << 1u);
+        if ((identifier & CANFRM_RTR_FLAG) != 0u) {   /* see, if remote transmission request           */
+            key |= 1uL;
+        }
+    } else {                                          /* otherwise: standard identifier                */
+        key = (identifier & CANFRM_STD_ID_MSK) << 21u;
+        if ((identifier & CANFRM_RTR_FLAG) != 0u) {   /* see, if remote transmission request           */
+            key |= (1uL << 20u);
+        }
+    }
+    return (key);                                     /* return arbitration key                        */
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                            CanBusTxPush()
+*
+* Description : Inserts a CAN frame in the transmit heap. The heap is ordered by the arbitration key of
+*               the frame identifier. Frames with equal keys are ordered by their sequence number, so
+*               they are transmitted in the order of insertion.
+*
+* Argument(s) : bus     Pointer to bus data
+*
+*               frm     Pointer to CAN frame, which shall be inserted
+*
+*               tag     Transmit confirmation tag of the frame (0: no confirmation)
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function must be called with disabled interrupts and only if a free entry is
+*               available. The given frame may be located within the transmit buffer behind the
+*               current end of the heap.
+*********************************************************************************************************
+*/
+
+#if (CANBUS_TX_HANDLER_EN > 0) && (CANBUS_TX_PRIO_EN > 0)
+static  void  CanBusTxPush (CANBUS_DATA  *bus,
+                            CANFRM       *frm,
+                            CPU_INT08U    tag)
+{
+    CANFRM      ins;                                  /* Local: copy of frame to insert                */
+    CPU_INT32U  key;                                  /* Local: arbitration key of frame               */
+    CPU_INT16U  seq;                                  /* Local: sequence number of frame               */
+    CPU_INT16U  pos;                                  /* Local: current heap position                  */
+    CPU_INT16U  par;                                  /* Local: parent heap position                   */
+    CPU_INT32U  pkey;                                 /* Local: arbitration key of parent              */
+
+
+    ins = *frm;                                       /* copy frame, the entry may be overwritten      */
+#if CANBUS_TX_CONFIRM_EN > 0
+    CANBUS_TX_TAG(&ins) = tag;                        /* set confirmation tag of the frame             */
+#else
+    (void)tag;                                        /* unused; prevent compiler warning              */
+#endif
+    key = CanBusTxKey(ins.Identifier);
+    seq = bus->TxSeq;
+    bus->TxSeq++;
+    pos = (CPU_INT16U)(bus->BufTxWr - bus->BufTxRd);  /* start at the end of the heap                  */
+    while (pos > 0u) {                                /* sift up until the heap order is restored      */
+        par  = (CPU_INT16U)((pos - 1u) >> 1u);
+        pkey = CanBusTxKey(bus->BufTx[par].Identifier);
+        if ((pkey < key) ||
+            ((pkey == key) && ((CPU_INT16S)(bus->BufTxSeq[par] - seq) < 0))) {
+            break;                                    /* parent wins arbitration: position found       */
+        }
+        bus->BufTx[pos]    = bus->BufTx[par];         /* move parent down                              */
+        bus->BufTxSeq[pos] = bus->BufTxSeq[par];
+        pos                = par;
+    }
+    bus->BufTx[pos]    = ins;                         /* place frame at found position                 */
+    bus->BufTxSeq[pos] = seq;
+    bus->BufTxWr++;                                   /* publish frame to TX-ISR                       */
+}
+
+
+/*
+*********************************************************************************************************
+*                                            CanBusTxPop()
+*
+* Description : Removes the frame with the highest priority (the root) from the transmit heap.
+*
+* Argument(s) : bus     Pointer to bus data
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function must be called with disabled interrupts and only if the heap is not empty.
+*********************************************************************************************************
+*/
+
+static  void  CanBusTxPop (CANBUS_DATA  *bus)
+{
+    CPU_INT16U  cnt;                                  /* Local: number of frames in heap after removal */
+    CPU_INT32U  key;                                  /* Local: arbitration key of last frame          */
+    CPU_INT16U  seq;                                  /* Local: sequence number of last frame          */
+    CPU_INT16U  pos;                                  /* Local: current heap position                  */
+    CPU_INT16U  chd;                                  /* Local: child heap position                    */
+    CPU_INT32U  ckey;                                 /* Local: arbitration key of child               */
+    CPU_INT32U  rkey;                                 /* Local: arbitration key of right child         */
+
+
+    cnt = (CPU_INT16U)(bus->BufTxWr - bus->BufTxRd - 1u);
+    bus->BufTxRd++;                                   /* release entry of the root frame               */
+    if (cnt == 0u) {                                  /* see, if heap is empty now                     */
+        return;
+    }
+    key = CanBusTxKey(bus->BufTx[cnt].Identifier);    /* last frame replaces the root frame            */
+    seq = bus->BufTxSeq[cnt];
+    pos = 0u;
+    chd = 1u;
+    while (chd < cnt) {                               /* sift down until the heap order is restored    */
+        ckey = CanBusTxKey(bus->BufTx[chd].Identifier);
+        if ((chd + 1u) < cnt) {                       /* see, if right child exists                    */
+            rkey = CanBusTxKey(bus->BufTx[chd + 1u].Identifier);
+            if ((rkey < ckey) ||                      /* yes: select child, which wins arbitration     */
+                ((rkey == ckey) &&
+                 ((CPU_INT16S)(bus->BufTxSeq[chd + 1u] - bus->BufTxSeq[chd]) < 0))) {
+                chd++;
+                ckey = rkey;
+            }
+        }
+        if ((key < ckey) ||
+            ((key == ckey) && ((CPU_INT16S)(seq - bus->BufTxSeq[chd]) < 0))) {
+            break;                                    /* last frame wins arbitration: position found   */
+        }
+        bus->BufTx[pos]    = bus->BufTx[chd];         /* move child up                                 */
+        bus->BufTxSeq[pos] = bus->BufTxSeq[chd];
+        pos                = chd;
+        chd                = (CPU_INT16U)((pos << 1u) + 1u);
+    }
+    bus->BufTx[pos]    = bus->BufTx[cnt];             /* place last frame at found position            */
+    bus->BufTxSeq[pos] = seq;
+}
+#endif                                                /* CANBUS_TX_PRIO_EN > 0                         */
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusTxSent()
+*
+* Description : Records a frame, which is written to the device and waits for the transmit confirmation.
+*
+* Argument(s) : bus     Pointer to bus data
+*
+*               tag     Transmit confirmation tag of the frame (0: no confirmation)
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function must be called with disabled interrupts and only if no frame waits for the
+*               confirmation (see CANBUS_TX_SENT_FULL()).
+*********************************************************************************************************
+*/
+
+#if CANBUS_TX_CONFIRM_EN > 0
+static  void  CanBusTxSent (CANBUS_DATA  *bus,
+                            CPU_INT08U    tag)
+{
+    bus->TxSent[bus->TxSentWr & (CANBUS_TX_CONFIRM_N - 1u)] = tag;
+    bus->TxSentWr++;                                  /* append tag in order of writing                */
+}
+
+
+/*
+*********************************************************************************************************
+*                                          CanBusTxConfirm()
+*
+* Description : Confirms the frame in the device and calls the confirmation function of the frame, if the
+*               frame is written with CanBusWriteAsync().
+*
+* Argument(s) : busId   Bus identifier
+*
+*               bus     Pointer to bus data
+*
+* Return(s)   : none.
+*
+* Note(s)     : Only one frame is written to the device at a time, so each transmit interrupt completes
+*               exactly this frame, independent of the transmission order of the device mailboxes.
+*********************************************************************************************************
+*/
+
+static  void  CanBusTxConfirm (CPU_INT16S    busId,
+                               CANBUS_DATA  *bus)
+{
+    CANBUS_TX_FUNC  func;                             /* Local: confirmation function                  */
+    void           *arg;                              /* Local: argument of confirmation function      */
+    CPU_INT08U      tag;                              /* Local: confirmation tag of sent frame         */
+
+
+    if (bus->TxSentRd == bus->TxSentWr) {             /* see, if no frame waits for confirmation       */
+        return;
+    }
+    tag = bus->TxSent[bus->TxSentRd & (CANBUS_TX_CONFIRM_N - 1u)];
+    bus->TxSentRd++;                                  /* remove sent frame                             */
+    if (tag != 0u) {                                  /* see, if frame needs a confirmation            */
+        func = bus->TxCbFunc[tag - 1u];
+        arg  = bus->TxCbArg[tag - 1u];
+        bus->TxCbFunc[tag - 1u] = NULL_PTR;           /* release entry before confirmation             */
+        func(busId, arg, CAN_ERR_NONE);               /* confirm successful transmission               */
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusTxFail()
+*
+* Description : Calls the confirmation function of a frame, which is dropped because the device rejected
+*               it, with the errorcode CAN_ERR_TXABORT.
+*
+* Argument(s) : bus     Pointer to bus data
+*
+*               tag     Transmit confirmation tag of the frame (0: no confirmation)
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function must be called with disabled interrupts.
+*********************************************************************************************************
+*/
+
+static  void  CanBusTxFail (CANBUS_DATA  *bus,
+                            CPU_INT08U    tag)
+{
+    CANBUS_TX_FUNC  func;                             /* Local: confirmation function                  */
+
+
+    if (tag != 0u) {                                  /* see, if frame needs a confirmation            */
+        func = bus->TxCbFunc[tag - 1u];
+        bus->TxCbFunc[tag - 1u] = NULL_PTR;           /* release entry before confirmation             */
+        func((CPU_INT16S)(bus - &CanBusTbl[0]),       /* confirm aborted transmission                  */
+             bus->TxCbArg[tag - 1u],
+             CAN_ERR_TXABORT);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusTxAbort()
+*
+* Description : Aborts the transmit confirmations of frames, which are removed from the transmit queue or
+*               from the device. The confirmation functions are called with CAN_ERR_TXABORT.
+*
+* Argument(s) : busId   Bus identifier
+*
+*               bus     Pointer to bus data
+*
+*               sent    CAN_TRUE: abort all frames, which are written to the device;
+*                       CAN_FALSE: abort all frames, which are still in the transmit queue
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function must be called with disabled interrupts.
+*********************************************************************************************************
+*/
+
+static  void  CanBusTxAbort (CPU_INT16S    busId,
+                             CANBUS_DATA  *bus,
+                             CPU_BOOLEAN   sent)
+{
+    CANBUS_TX_FUNC  func;                             /* Local: confirmation function                  */
+    CPU_INT16U      i;                                /* Local: loop variable                          */
+    CPU_INT16U      rd;                               /* Local: read counter of sent frames            */
+    CPU_INT08U      tag;                              /* Local: confirmation tag                       */
+
+
+    for (i = 0u; i < CANBUS_TX_CONFIRM_N; i++) {      /* loop through all confirmation entries         */
+        if (bus->TxCbFunc[i] == NULL_PTR) {           /* see, if entry is unused                       */
+            continue;
+        }
+        tag = (CPU_INT08U)(i + 1u);
+        rd  = bus->TxSentRd;
+        while ((rd != bus->TxSentWr) &&               /* search frame in device                        */
+               (bus->TxSent[rd & (CANBUS_TX_CONFIRM_N - 1u)] != tag)) {
+            rd++;
+        }
+        if ((rd != bus->TxSentWr) == (sent == CAN_TRUE)) { /* see, if frame is in selected location    */
+            func = bus->TxCbFunc[i];
+            bus->TxCbFunc[i] = NULL_PTR;              /* release entry                                 */
+            func(busId, bus->TxCbArg[i], CAN_ERR_TXABORT);
+        }
+    }
+    if (sent == CAN_TRUE) {                           /* see, if device frames are aborted             */
+        bus->TxSentRd = bus->TxSentWr;                /* yes: no frame waits for confirmation          */
+    }
+}
+#endif                                                /* CANBUS_TX_CONFIRM_EN > 0                      */
+
+
+/*
+*********************************************************************************************************
+*                                         CanBusFilterClear()
+*
+* Description : Removes all identifiers from the software acceptance filter of the bus.
+*
+* Argument(s) : bus     Pointer to bus data
+*
+* Return(s)   : none.
+*
+* Note(s)     : Each step is done within a short critical section, so the receive handler may check
+*               the filter at any time and the interrupt latency doesn't depend on the bitmap size.
+*********************************************************************************************************
+*/
+
+#if CANBUS_FILTER_EN > 0
+static  void  CanBusFilterClear (CANBUS_DATA  *bus)
+{
+    CPU_INT16U  i;                                    /* Local: loop variable                          */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+    CPU_CRITICAL_ENTER();                             /* remove all extended identifiers               */
+    bus->FilterExtNum = 0u;
+    CPU_CRITICAL_EXIT();
+    for (i = 0u; i < ((CANFRM_STD_ID_MSK + 1u) / 32u); i++) {
+        CPU_CRITICAL_ENTER();                         /* remove all standard identifiers               */
+        bus->FilterStd[i] = 0u;
+        CPU_CRITICAL_EXIT();
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CanBusFilterAccept()
+*
+* Description : Checks the identifier of a received frame against the software acceptance filter. A
+*               standard identifier is checked with the bitmap, an extended identifier is searched
+*               in the sorted table with a binary search.
+*
+* Argument(s) : bus          Pointer to bus data
+*
+*               identifier   The identifier of the received frame, including RTR and EXT flag
+*
+* Return(s)   : CAN_TRUE, if the frame is accepted, otherwise CAN_FALSE.
+*
+* Note(s)     : -
+*********************************************************************************************************
+*/
+
+#if CANBUS_RX_HANDLER_EN > 0
+static  CPU_BOOLEAN  CanBusFilterAccept (CANBUS_DATA  *bus,
+                                         CPU_INT32U    identifier)
+{
+    CPU_INT32U  id;                                   /* Local: identifier without flags               */
+    CPU_INT16U  lo;                                   /* Local: lower bound of search range            */
+    CPU_INT16U  hi;                                   /* Local: upper bound of search range            */
+    CPU_INT16U  mid;                                  /* Local: middle of search range                 */
+
+
+    if (bus->FilterOn != CAN_TRUE) {                  /* see, if filter is disabled                    */
+        return (CAN_TRUE);                            /* yes: accept all frames                        */
+    }
+    if ((identifier & CANFRM_EXT_FLAG) == 0u) {       /* see, if identifier is standard                */
+        id = identifier & CANFRM_STD_ID_MSK;
+        if ((bus->FilterStd[id >> 5u] & (1uL << (id & 31u))) != 0u) {
+            return (CAN_TRUE);
+        }
+        return (CAN_FALSE);
+    }
+    id = identifier & CANFRM_EXT_ID_MSK;              /* otherwise: search extended identifier         */
+    lo = 0u;
+    hi = bus->FilterExtNum;
+    while (lo < hi) {
+        mid = (CPU_INT16U)(lo + ((hi - lo) >> 1u));
+        if (bus->FilterExt[mid] < id) {
+            lo = mid + 1u;
+        } else if (bus->FilterExt[mid] > id) {
+            hi = mid;
+        } else {
+            return (CAN_TRUE);                        /* identifier found: accept frame                */
+        }
+    }
+    return (CAN_FALSE);
+}
+#endif                                                /* CANBUS_RX_HANDLER_EN > 0                      */
+
+
+/*
+*********************************************************************************************************
+*                                          CanBusFilterSet()
+*
+* Description : Adds an identifier to or removes an identifier from the software acceptance filter.
+*
+* Argument(s) : bus          Pointer to bus data
+*
+*               identifier   The identifier, including the EXT flag for extended identifiers
+*
+*               accept       CAN_TRUE to add the identifier, CAN_FALSE to remove the identifier
+*
+* Return(s)   : Errorcode CAN_ERR_BUFFSIZE, if the extended identifier table is full, otherwise
+*               CAN_ERR_NONE.
+*
+* Note(s)     : Adding an existing or removing a missing identifier is no error. The extended identifier
+*               table is moved entry by entry, each within a short critical section. The table stays
+*               sorted after each step, so the receive handler may search it at any time and the
+*               interrupt latency doesn't depend on the table size. The filter of a bus must not be
+*               changed by several tasks at the same time.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16S  CanBusFilterSet (CANBUS_DATA  *bus,
+                                     CPU_INT32U    identifier,
+                                     CPU_BOOLEAN   accept)
+{
+    CPU_INT32U  id;                                   /* Local: identifier without flags               */
+    CPU_INT16U  num;                                  /* Local: number of extended identifiers         */
+    CPU_INT16U  pos;                                  /* Local: position in extended identifier table  */
+    CPU_INT16U  i;                                    /* Local: loop variable                          */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+    if ((identifier & CANFRM_EXT_FLAG) == 0u) {       /* see, if identifier is standard                */
+        id = identifier & CANFRM_STD_ID_MSK;
+        CPU_CRITICAL_ENTER();                         /* disable all interrupts                        */
+        if (accept == CAN_TRUE) {
+            bus->FilterStd[id >> 5u] |=  (1uL << (id & 31u));
+        } else {
+            bus->FilterStd[id >> 5u] &= ~(1uL << (id & 31u));
+        }
+        CPU_CRITICAL_EXIT();                          /* enable all interrupts                         */
+        return (CAN_ERR_NONE);
+    }
+    id  = identifier & CANFRM_EXT_ID_MSK;             /* otherwise: extended identifier                */
+    num = bus->FilterExtNum;
+    pos = 0u;
+    while ((pos < num) && (bus->FilterExt[pos] < id)) { /* find position in sorted table               */
+        pos++;
+    }
+    if ((pos < num) && (bus->FilterExt[pos] == id)) { /* see, if identifier is in table                */
+        if (accept != CAN_TRUE) {                     /* yes: remove identifier from table             */
+            for (i = pos; (i + 1u) < num; i++) {      /* overwrite with the following identifiers      */
+                CPU_CRITICAL_ENTER();
+                bus->FilterExt[i] = bus->FilterExt[i + 1u];
+                CPU_CRITICAL_EXIT();
+            }
+            CPU_CRITICAL_ENTER();                     /* drop duplicated last identifier               */
+            bus->FilterExtNum = num - 1u;
+            CPU_CRITICAL_EXIT();
+        }
+    } else if (accept == CAN_TRUE) {                  /* otherwise: insert identifier in table         */
+        if (num >= CANBUS_FILTER_EXT_N) {
+            return (CAN_ERR_BUFFSIZE);                /* no space in table                             */
+        }
+        if (pos < num) {                              /* see, if greater identifiers must be moved     */
+            bus->FilterExt[num] = bus->FilterExt[num - 1u]; /* yes: duplicate last identifier          */
+        } else {
+            bus->FilterExt[num] = id;                 /* no: append identifier                         */
+        }
+        CPU_CRITICAL_ENTER();                         /* enlarge table                                 */
+        bus->FilterExtNum = num + 1u;
+        CPU_CRITICAL_EXIT();
+        if (pos < num) {
+            for (i = num - 1u; i > pos; i--) {        /* move greater identifiers up                   */
+                CPU_CRITICAL_ENTER();
+                bus->FilterExt[i] = bus->FilterExt[i - 1u];
+                CPU_CRITICAL_EXIT();
+            }
+            CPU_CRITICAL_ENTER();                     /* place identifier                              */
+            bus->FilterExt[pos] = id;
+            CPU_CRITICAL_EXIT();
+        }
+    }
+    return (CAN_ERR_NONE);
+}
+#endif                                                /* CANBUS_FILTER_EN > 0                          */
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusSubRoute()
+*
+* Description : Delivers a received CAN frame to the first receive subscriber of the bus with a matching
+*               identifier.
+*
+* Argument(s) : busId   bus identifier
+*
+*               frm     Pointer to the received CAN frame
+*
+* Return(s)   : 1, if the frame belongs to a subscriber, otherwise 0.
+*
+* Note(s)     : This function is called by the RX-ISR. A frame, which belongs to a subscriber with a
+*               full queue, is lost for the subscriber and is not stored in the bus receive queue.
+*********************************************************************************************************
+*/
+
+#if (CANBUS_SUB_EN > 0) && (CANBUS_RX_HANDLER_EN > 0)
+static  CPU_INT16S  CanBusSubRoute (CPU_INT16S   busId,
+                                    CANFRM      *frm)
+{
+    CANBUS_SUB  *sub = &CanBusSubTbl[0];              /* Local: pointer to subscriber                  */
+    CPU_INT16U   i;                                   /* Local: loop variable                          */
+    CPU_INT16U   wr;                                  /* Local: subscriber write counter               */
+
+
+    for (i = 0u; i < CANBUS_SUB_N; i++) {             /* loop through all receive subscribers          */
+        if ((sub->BusId == busId) &&                  /* see, if subscriber matches the frame          */
+            (((frm->Identifier ^ sub->Identifier) & sub->Mask) == 0u)) {
+            wr = sub->Wr;                             /* get write counter (only written by this ISR)  */
+            if ((CPU_INT16U)(wr - sub->Rd) <= sub->QMask) {
+                sub->Buf[wr & sub->QMask] = *frm;     /* copy frame to subscriber queue                */
+                CANBUS_MB();                          /* complete entry before publishing it           */
+                sub->Wr = wr + 1u;                    /* publish frame to subscriber                   */
+                CANOS_PostSubFrame((CPU_INT16S)i);    /* signal a new CAN frame to subscriber          */
+            } else {                                  /* otherwise: subscriber queue is full           */
+#if CANBUS_STAT_EN > 0
+                sub->Lost++;                          /* increment subscriber lost counter             */
+#endif
+            }
+            return (1);
+        }
+        sub++;
+    }
+    return (0);                                       /* frame is not subscribed                       */
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusGwRoute()
+*
+* Description : Forwards a received CAN frame with the first matching gateway route of the bus to all
+*               destination busses of the route.
+*
+* Argument(s) : busId   Bus identifier
+*
+*               bus     Pointer to bus data
+*
+*               frm     Pointer to the received CAN frame
+*
+* Return(s)   : 1, if the frame matches a gateway route, otherwise 0.
+*
+* Note(s)     : A matching frame with an unexpected data length code is dropped. The identifier of the
+*               forwarded frame is rewritten with the rewrite identifier and mask of the route.
+*********************************************************************************************************
+*/
+
+#if CANBUS_GW_EN > 0
+static  CPU_INT16S  CanBusGwRoute (CPU_INT16S    busId,
+                                   CANBUS_DATA  *bus,
+                                   CANFRM       *frm)
+{
+    CANBUS_GW           *gw = &CanBusGwTbl[0];        /* Local: pointer to gateway route entry         */
+    const CANBUS_ROUTE  *route;                       /* Local: pointer to routing rule                */
+    CANFRM               fwd;                         /* Local: forwarded CAN frame                    */
+    CPU_INT32U           dst;                         /* Local: remaining destination busses           */
+    CPU_INT16U           n;                           /* Local: destination bus identifier             */
+    CPU_INT16U           i;                           /* Local: loop variable                          */
+
+
+    (void)bus;                                        /* prevent compiler warnings                     */
+    for (i = 0u; i < CANBUS_GW_N; i++) {              /* loop through all gateway routes               */
+        route = gw->Route;
+        if ((gw->BusId == busId) &&                   /* see, if route matches the frame               */
+            (((frm->Identifier ^ route->Identifier) & route->Mask) == 0u)) {
+            if ((route->DLC != CANBUS_GW_DLC_ANY) &&  /* see, if data length code is unexpected        */
+                (route->DLC != frm->DLC)) {
+#if CANBUS_STAT_EN > 0
+                bus->GwDlcErr++;                      /* yes: drop frame                               */
+#endif
+                return (1);
+            }
+            fwd            = *frm;                    /* rewrite identifier of forwarded frame         */
+            fwd.Identifier = (frm->Identifier & ~route->RwMask) | (route->RwId & route->RwMask);
+            dst            = route->DstMask;
+            for (n = 0u; dst != 0u; n++) {            /* loop through all destination busses           */
+                if ((dst & 1u) != 0u) {
+                    CanBusGwSend(&CanBusTbl[n], &fwd);
+                }
+                dst >>= 1u;
+            }
+            return (1);
+        }
+        gw++;
+    }
+    return (0);                                       /* frame is not routed                           */
+}
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusGwSend()
+*
+* Description : Transmits a forwarded CAN frame on the destination bus. The frame is written directly to
+*               the device, if the device is ready and no other forwarded frame is pending. Otherwise
+*               the frame is stored in the gateway transmit queue of the destination bus.
+*
+* Argument(s) : dst     Pointer to bus data of the destination bus
+*
+*               frm     Pointer to the forwarded CAN frame
+*
+* Return(s)   : none.
+*
+* Note(s)     : The gateway transmit queue is emptied by CanBusTxHandler() of the destination bus.
+*********************************************************************************************************
+*/
+
+static  void  CanBusGwSend (CANBUS_DATA  *dst,
+                            CANFRM       *frm)
+{
+    CANBUS_PARA  *cfg;                                /* Local: pointer to bus configuration           */
+    CPU_INT16S    err;                                /* Local: errorcode of device driver             */
+    CPU_INT16U    wr;                                 /* Local: gateway queue write counter            */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+    CPU_CRITICAL_ENTER();                             /* queue is shared by all source busses          */
+    cfg = dst->Cfg;
+    if (cfg == NULL_PTR) {                            /* see, if destination bus is not enabled        */
+        CPU_CRITICAL_EXIT();
+        return;
+    }
+    wr = dst->GwWr;
+    if (wr == dst->GwRd) {                            /* see, if no forwarded frame is pending         */
+        if (
+#if CANBUS_TX_CONFIRM_EN > 0
+            (!CANBUS_TX_SENT_FULL(dst)) &&            /* and no frame waits for confirmation           */
+#endif
+            (CanBusTxReady(dst) == CAN_TRUE)) {       /* and the device is ready                       */
+            err = cfg->Write(dst->Dev, (void *)frm,   /* write can frame to can bus interface          */
+                             CANFRM_DRV_SIZE);
+            if (err == (CPU_INT16S)CANFRM_DRV_SIZE) { /* see, if frame is accepted by the device       */
+#if CANBUS_STAT_EN > 0
+                dst->TxOk++;                          /* increment transmission counter                */
+                dst->TxBits += CanBusFrmBits(frm);    /* add frame to transmitted bus bits             */
+                dst->GwFwd++;
+#endif
+#if CANBUS_TX_CONFIRM_EN > 0
+                CanBusTxSent(dst, 0u);                /* frame needs no confirmation                   */
+#endif
+                CPU_CRITICAL_EXIT();
+                return;
+            }
+            CANSetErrRegister(err);                   /* otherwise: queue frame for TX-ISR             */
+        }
+    }
+    if ((CPU_INT16U)(wr - dst->GwRd) < CANBUS_GW_QSIZE) { /* see, if gateway queue has a free entry    */
+        dst->BufGw[wr & (CANBUS_GW_QSIZE - 1u)] = *frm;
+        CANBUS_MB();                                  /* complete entry before publishing it           */
+        dst->GwWr = wr + 1u;
+#if CANBUS_STAT_EN > 0
+        dst->GwFwd++;
+#endif
+    } else {                                          /* otherwise: gateway queue is full              */
+#if CANBUS_STAT_EN > 0
+        dst->GwLost++;                                /* increment gateway lost counter                */
+#endif
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusGwStart()
+*
+* Description : Writes the oldest frame out of the gateway transmit queue to the CAN bus device.
+*
+* Argument(s) : bus     Pointer to bus data
+*
+* Return(s)   : CAN_TRUE, if a forwarded frame is written to the device, otherwise CAN_FALSE.
+*
+* Note(s)     : This function is called by the TX-ISR, when the device is ready for transmission. A frame,
+*               which is rejected by the device, is dropped (and counted as driver error), so a single
+*               driver error can't stall the gateway transmit queue.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  CanBusGwStart (CANBUS_DATA  *bus)
+{
+    CANBUS_PARA  *cfg = bus->Cfg;                     /* Local: pointer to bus configuration           */
+    CANFRM       *frm;                                /* Local: pointer to next forwarded frame        */
+    CPU_INT16S    err;                                /* Local: errorcode of device driver             */
+    CPU_BOOLEAN   sent = CAN_FALSE;                   /* Local: function result                        */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+    CPU_CRITICAL_ENTER();                             /* queue is shared with the receive handlers     */
+    if (bus->GwRd != bus->GwWr) {                     /* see, if forwarded frames are pending          */
+        frm = &bus->BufGw[bus->GwRd & (CANBUS_GW_QSIZE - 1u)];
+        err = cfg->Write(bus->Dev, (void *)frm,       /* write can frame to can bus interface          */
+                         CANFRM_DRV_SIZE);
+        if (err == (CPU_INT16S)CANFRM_DRV_SIZE) {     /* see, if frame is accepted by the device       */
+#if CANBUS_STAT_EN > 0
+            bus->TxOk++;                              /* increment transmission counter                */
+            bus->TxBits += CanBusFrmBits(frm);        /* add frame to transmitted bus bits             */
+#endif
+#if CANBUS_TX_CONFIRM_EN > 0
+            CanBusTxSent(bus, 0u);                    /* frame needs no confirmation                   */
+#endif
+            sent = CAN_TRUE;
+        } else {                                      /* otherwise: drop the rejected frame            */
+            CANSetErrRegister(err);
+#if CANBUS_STAT_EN > 0
+            bus->TxErr++;                             /* increment driver error counter                */
+#endif
+        }
+        bus->GwRd++;                                  /* release entry                                 */
+    }
+    CPU_CRITICAL_EXIT();
+
+    return (sent);
+}
+#endif                                                /* CANBUS_GW_EN > 0                              */
+
+
+/*
+*********************************************************************************************************
+*                                          CanBusRxProcess()
+*
+* Description : Processes a received frame with the software acceptance filter, the receive hook, the
+*               gateway routes, the receive subscribers and the CAN messages.
+*
+* Argument(s) : busId   Bus identifier
+*
+*               bus     Pointer to bus data
+*
+*               frm     Pointer to the received frame
+*
+* Return(s)   : 0, if the frame shall be stored in the receive buffer, otherwise the frame is consumed.
+*
+* Note(s)     : With CANBUS_RX_DEFER_EN this function is called by the service task, otherwise by the
+*               receive interrupt or, while the bus is polled, by CanBusRxPoll().
+*********************************************************************************************************
+*/
+
+#if CANBUS_RX_HANDLER_EN > 0
+static  CPU_INT16S  CanBusRxProcess (CPU_INT16S    busId,
+                                     CANBUS_DATA  *bus,
+                                     CANFRM       *frm)
+{
+    CPU_INT16S  consumed = 0;                         /* Local: return value of hook                   */
+#if (CANBUS_FILTER_EN > 0) && ((CANBUS_RX_DEFER_EN > 0) || (CANBUS_RX_POLL_EN > 0))
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+#endif
+
+
+    (void)busId;                                      /* prevent compiler warnings                     */
+    (void)bus;
+    (void)frm;
+#if CANBUS_STAT_EN > 0
+    bus->RxBits += CanBusFrmBits(frm);                /* add frame to received bus bits                */
+#endif
+
+#if CANBUS_FILTER_EN > 0
+#if (CANBUS_RX_DEFER_EN > 0) || (CANBUS_RX_POLL_EN > 0)
+    CPU_CRITICAL_ENTER();                             /* filter may be changed by a task               */
+#endif
+    if (CanBusFilterAccept(bus, frm->Identifier) == CAN_FALSE) { /* see, if frame is rejected       */
+        consumed = 1;                                 /* yes: drop frame without further processing    */
+    }
+#if (CANBUS_RX_DEFER_EN > 0) || (CANBUS_RX_POLL_EN > 0)
+    CPU_CRITICAL_EXIT();
+#endif
+#endif                                                /* CANBUS_FILTER_EN > 0                          */
+
+#if CANBUS_HOOK_RX_EN == 1
+    if (consumed == 0) {                              /* see, if frame is not yet consumed             */
+        consumed = CanBusRxHook(busId, (void *)frm);
+    }
+#endif                                                /* CANBUS_HOOK_RX_EN == 1                        */
+
+#if CANBUS_GW_EN > 0
+    if ((consumed == 0) && (bus->RouteNum != 0u)) {   /* see, if frame is routed to other busses       */
+        consumed = CanBusGwRoute(busId, bus, frm);
+    }
+#endif                                                /* CANBUS_GW_EN > 0                              */
+
+#if CANBUS_SUB_EN > 0
+    if ((consumed == 0) && (bus->SubNum != 0u)) {     /* see, if frame is for a receive subscriber     */
+        consumed = CanBusSubRoute(busId, frm);
+    }
+#endif                                                /* CANBUS_SUB_EN > 0                             */
+
+#if CANBUS_RX_MSG_EN > 0
+    if ((consumed == 0) && (bus->RxMsg == CAN_TRUE)) {/* see, if frame is unpacked into a message      */
+        if (CanMsgDispatch(frm) >= 0) {               /* yes: destruct frame into the linked signals   */
+            consumed = 1;                             /* frame of a message is not stored              */
+        }
+    }
+#endif                                                /* CANBUS_RX_MSG_EN > 0                          */
+
+    return (consumed);
+}
+#endif                                                /* CANBUS_RX_HANDLER_EN > 0                      */
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusRxPost()
+*
+* Description : Signals new frames in the receive buffer to the reader. With an enabled coalescing, the
+*               signal is delayed until the configured number of frames is reached or the configured
+*               time since the first not signalled frame is elapsed.
+*
+* Argument(s) : busId   Bus identifier
+*
+*               bus     Pointer to bus data
+*
+*               num     Number of new frames
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function is called by the producer of the receive buffer.
+*********************************************************************************************************
+*/
+
+#if CANBUS_RX_HANDLER_EN > 0
+static  void  CanBusRxPost (CPU_INT16S    busId,
+                            CANBUS_DATA  *bus,
+                            CPU_INT16U    num)
+{
+#if CANBUS_RX_COALESCE_EN > 0
+    CPU_INT32U  now;                                  /* Local: current time                           */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+    if (bus->RxCoalFrames > 1u) {                     /* see, if signals are coalesced                 */
+        now = CANOS_GetTime();
+        CPU_CRITICAL_ENTER();                         /* counter is shared with readers and timer      */
+        if (bus->RxUnposted == 0u) {                  /* see, if first not signalled frame             */
+            bus->RxFirst = now;
+        }
+        num += bus->RxUnposted;
+        if ((num < bus->RxCoalFrames) &&              /* see, if frames and time are below the limits  */
+            ((CPU_INT32U)(now - bus->RxFirst) < bus->RxCoalTime)) {
+            bus->RxUnposted = num;                    /* yes: delay the signal                         */
+            num             = 0u;
+        } else {
+            bus->RxUnposted = 0u;                     /* otherwise: signal all frames                  */
+        }
+        CPU_CRITICAL_EXIT();
+        if (num == 0u) {
+            return;
+        }
+    }
+#else
+    (void)bus;                                        /* unused; prevent compiler warning              */
+#endif
+
+    if (num == 1u) {                                  /* see, if a single frame is signalled           */
+        CANOS_PostRxFrame(busId);                     /* signal a new CAN frame in receive buffer      */
+    } else {
+        CANOS_PostRxFrameN(busId, num);               /* signal all new frames with a single post      */
+    }
+#if CANBUS_WAIT_EN > 0
+    CANOS_PostRxFlag(busId);                          /* signal frames to task waiting for any bus     */
+#endif
+}
+#endif                                                /* CANBUS_RX_HANDLER_EN > 0                      */
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusRxFlush()
+*
+* Description : Signals all coalesced frames of the bus to the reader.
+*
+* Argument(s) : busId   Bus identifier
+*
+*               bus     Pointer to bus data
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function is called by the readers before waiting for frames, so a running reader
+*               gets the published frames without delay, and by CanBusRxTimer().
+*********************************************************************************************************
+*/
+
+#if CANBUS_RX_COALESCE_EN > 0
+static  void  CanBusRxFlush (CPU_INT16S    busId,
+                             CANBUS_DATA  *bus)
+{
+    CPU_INT16U  num;                                  /* Local: number of coalesced frames             */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+    CPU_CRITICAL_ENTER();                             /* counter is shared with the receive interrupt  */
+    num             = bus->RxUnposted;
+    bus->RxUnposted = 0u;
+    CPU_CRITICAL_EXIT();
+    if (num > 0u) {                                   /* see, if frames are coalesced                  */
+        CANOS_PostRxFrameN(busId, num);               /* signal all coalesced frames                   */
+#if CANBUS_WAIT_EN > 0
+        CANOS_PostRxFlag(busId);                      /* signal frames to task waiting for any bus     */
+#endif
+    }
+}
+#endif                                                /* CANBUS_RX_COALESCE_EN > 0                     */
+
+
+/*
+*********************************************************************************************************
+*                                          CanBusRxPublish()
+*
+* Description : Publishes all frames up to the given write counter to the application with a single
+*               update of the write counter and a single post of the receive semaphore.
+*
+* Argument(s) : busId   Bus identifier
+*
+*               bus     Pointer to bus data
+*
+*               wr      New receive buffer write counter
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function is called by the producer of the receive buffer.
+*********************************************************************************************************
+*/
+
+#if CANBUS_RX_HANDLER_EN > 0
+static  void  CanBusRxPublish (CPU_INT16S    busId,
+                               CANBUS_DATA  *bus,
+                               CPU_INT16U    wr)
+{
+    CPU_INT16U  n;                                    /* Local: number of new frames                   */
+
+
+    n = (CPU_INT16U)(wr - bus->BufRxWr);
+    if (n > 0u) {                                     /* see, if frames are accepted                   */
+        CANBUS_MB();                                  /* complete entries before publishing them       */
+        bus->BufRxWr = wr;                            /* publish all frames to application             */
+#if CANBUS_STAT_EN > 0
+        CanBusStatHwm(&bus->RxHwm, (CPU_INT16U)(wr - bus->BufRxRd));
+#endif
+        CanBusRxPost(busId, bus, n);                  /* signal all new frames with a single post      */
+    }
+}
+#endif                                                /* CANBUS_RX_HANDLER_EN > 0                      */
+
+
+/*
+*********************************************************************************************************
+*                                            CanBusRxShed()
+*
+* Description : Applies the receive overflow policy of the bus to a received frame, which finds the
+*               receive buffer full.
+*
+* Argument(s) : busId   Bus identifier
+*
+*               bus     Pointer to bus data
+*
+*               frm     Pointer to received frame
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function is called by the producer of the receive buffer. Only frames, which are
+*               not handed out by CanBusRxPeek(), are removed. The frames behind a removed frame are
+*               moved forward, so the receive order and the number of frames in the buffer (and the
+*               receive semaphore) are kept. The oldest frame is removed by moving the read counter,
+*               if no frame is handed out.
+*********************************************************************************************************
+*/
+
+#if CANBUS_RX_POLICY_EN > 0
+static  void  CanBusRxShed (CPU_INT16S    busId,
+                            CANBUS_DATA  *bus,
+                            CANFRM       *frm)
+{
+    CPU_INT16U   rd;                                  /* Local: first entry, which is not handed out   */
+    CPU_INT16U   wr;                                  /* Local: receive buffer write counter           */
+    CPU_INT16U   pos;                                 /* Local: entry of the lost frame                */
+    CPU_INT32U   key;                                 /* Local: arbitration key of the lost frame      */
+    CPU_INT32U   k;                                   /* Local: arbitration key of the queued frame    */
+    CPU_BOOLEAN  post = CAN_FALSE;                    /* Local: indication for a published frame       */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+    CPU_CRITICAL_ENTER();                             /* consumer releases entries in critical section */
+    rd  = bus->BufRxRd + bus->RxPeek;
+    wr  = bus->BufRxWr;
+    pos = wr;                                         /* default: the received frame is lost           */
+    if ((CPU_INT16U)(wr - bus->BufRxRd) <= bus->RxMask) { /* see, if an entry is released meanwhile    */
+        bus->BufRx[wr & bus->RxMask] = *frm;          /* yes: queue received frame                     */
+        CANBUS_MB();                                  /* complete entry before publishing it           */
+        bus->BufRxWr = wr + 1u;
+        post = CAN_TRUE;
+    } else if (rd != wr) {                            /* see, if frames are not handed out             */
+        if (bus->RxPolicy == CANBUS_RX_DROP_OLDEST) {
+            pos = rd;                                 /* lose oldest frame                             */
+        } else if (bus->RxPolicy == CANBUS_RX_EVICT_PRIO) {
+            key = CanBusTxKey(frm->Identifier);       /* lose oldest frame with the lowest priority    */
+            for (; rd != wr; rd++) {
+                k = CanBusTxKey(bus->BufRx[rd & bus->RxMask].Identifier);
+                if (k > key) {
+                    key = k;
+                    pos = rd;
+                }
+            }
+        }
+    }
+
+    if (post == CAN_FALSE) {                          /* see, if a frame is lost                       */
+        if (pos == bus->BufRxRd) {                    /* see, if the oldest frame is not handed out    */
+            bus->BufRx[pos & bus->RxMask] = *frm;     /* replace oldest frame with received frame      */
+            bus->BufRxRd = pos + 1u;                  /* (write entry is the read entry in full buffer)*/
+            bus->BufRxWr = wr  + 1u;
+        } else if (pos != wr) {                       /* otherwise, see if a queued frame is lost      */
+            for (; (CPU_INT16U)(pos + 1u) != wr; pos++) { /* move following frames forward             */
+                bus->BufRx[pos & bus->RxMask] = bus->BufRx[(CPU_INT16U)(pos + 1u) & bus->RxMask];
+            }
+            bus->BufRx[pos & bus->RxMask] = *frm;     /* append received frame                         */
+        }
+#if CANBUS_STAT_EN > 0
+        bus->RxLost++;                                /* Increment receive CAN frame lost counter      */
+        if (pos == wr) {                              /* count lost frame with the applied policy      */
+            bus->RxDropNewest++;                      /* (received frame is lost, e.g. all handed out) */
+        } else if (bus->RxPolicy == CANBUS_RX_DROP_OLDEST) {
+            bus->RxDropOldest++;
+        } else {
+            bus->RxEvicted++;
+        }
+#endif
+    }
+    CPU_CRITICAL_EXIT();
+
+    if (post == CAN_TRUE) {                           /* see, if received frame is published           */
+        CanBusRxPost(busId, bus, 1u);                 /* signal a new CAN frame in receive buffer      */
+    }
+}
+#endif                                                /* CANBUS_RX_POLICY_EN > 0                       */
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusRxMode()
+*
+* Description : Switches the reception of the bus between the receive interrupt and polling, when the
+*               load period is elapsed. The receive interrupt is disabled, if the number of frames in
+*               the period reaches the enter threshold, and enabled again, if the number of polled
+*               frames in the period is below the leave threshold.
+*
+* Argument(s) : bus     Pointer to bus data
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The switch to polling is done by the receive interrupt, the switch back by
+*                   CanBusRxPoll(). Therefore the bus is read by a single context at any time.
+*
+*               (2) A period, which is elapsed for more than twice the period length without a
+*                   receive interrupt, is not used for switching to polling.
+*********************************************************************************************************
+*/
+
+#if CANBUS_RX_POLL_EN > 0
+static  void  CanBusRxMode (CANBUS_DATA  *bus)
+{
+    CPU_INT32U  now;                                  /* Local: current time                           */
+    CPU_INT32U  elapsed;                              /* Local: elapsed time in current period         */
+    CPU_INT16S  err;                                  /* Local: driver errorcode                       */
+
+
+    now     = CANOS_GetTime();
+    elapsed = (CPU_INT32U)(now - bus->RxPollTime);
+    if (elapsed < bus->RxPollPeriod) {                /* see, if load period is not elapsed            */
+        return;
+    }
+    if (bus->RxPolling == CAN_FALSE) {                /* see, if receive interrupt is used (1)         */
+        if ((bus->RxPollOn != 0u) &&                  /* see, if receive load reaches enter threshold  */
+            (bus->RxPollCnt >= bus->RxPollOn) &&
+            ((elapsed / 2u) < bus->RxPollPeriod)) {   /* (2)                                           */
+            err = bus->Cfg->RxIrq(bus->Dev, 0u);      /* disable receive interrupt of the device       */
+            CANSetErrRegister(err);
+            if (err >= 0) {                           /* see, if interrupt is disabled                 */
+                bus->RxPolling = CAN_TRUE;            /* yes: read bus with CanBusRxPoll()             */
+#if CANBUS_STAT_EN > 0
+                bus->RxPollEnter++;
+#endif
+            }
+        }
+    } else if ((bus->RxPollCnt < bus->RxPollOff) ||   /* see, if polled load is below leave threshold  */
+               (bus->RxPollOn == 0u)) {               /* or polling is disabled meanwhile              */
+        bus->RxPolling = CAN_FALSE;                   /* stop polling before the interrupt may occur   */
+        err = bus->Cfg->RxIrq(bus->Dev, 1u);          /* enable receive interrupt of the device        */
+        CANSetErrRegister(err);
+#if CANBUS_STAT_EN > 0
+        bus->RxPollLeave++;
+#endif
+    }
+    bus->RxPollCnt  = 0u;                             /* start next load period                        */
+    bus->RxPollTime = now;
+}
+#endif                                                /* CANBUS_RX_POLL_EN > 0                         */
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusRxRead()
+*
+* Description : Reads a single frame out of the device. With a driver burst read function the frame is
+*               read with ReadN(), otherwise with Read().
+*
+* Argument(s) : bus     Pointer to bus data
+*
+*               frm     Pointer to CAN frame
+*
+* Return(s)   : CANFRM_DRV_SIZE, if a frame is read, otherwise the errorcode of the driver (or -1, if no
+*               frame is pending).
+*
+* Note(s)     : A driver with a burst read function releases the device receive mailbox of each read
+*               frame itself, so the receive interrupt must not release it. Therefore every frame of such
+*               a device is read with ReadN(), including frames, which are discarded because of a full
+*               receive buffer.
+*********************************************************************************************************
+*/
+
+#if CANBUS_RX_HANDLER_EN > 0
+static  CPU_INT16S  CanBusRxRead (CANBUS_DATA  *bus,
+                                  CANFRM       *frm)
+{
+    CANBUS_PARA  *cfg = bus->Cfg;                     /* Local: pointer to bus configuration           */
+    CPU_INT16S    err;                                /* Local: errorcode of device driver             */
+
+
+    if (cfg->ReadN != NULL_PTR) {                     /* see, if driver supports burst read            */
+        err = cfg->ReadN(bus->Dev,                    /* yes: read and release a single frame          */
+                         (CPU_INT08U *)frm,
+                         (CPU_INT16U)sizeof(CANFRM),
+                         1u);
+        if (err == 1) {
+            err = (CPU_INT16S)CANFRM_DRV_SIZE;        /* frame is read                                 */
+        } else if (err == 0) {
+            err = -1;                                 /* no frame is pending                           */
+        }
+    } else {
+        err = cfg->Read(bus->Dev, (void *)frm,        /* read can frame from can bus interface         */
+                        CANFRM_DRV_SIZE);
+    }
+    return (err);
+}
+#endif                                                /* CANBUS_RX_HANDLER_EN > 0                      */
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusRxBurst()
+*
+* Description : Reads all pending frames of the device with the driver burst read function into the
+*               receive buffer. The accepted frames are published with a single update of the receive
+*               buffer and a single post of the receive semaphore.
+*
+* Argument(s) : busId   Bus identifier
+*
+*               bus     Pointer to bus data
+*
+* Return(s)   : CAN_TRUE, if the receive buffer is full and the device may hold further frames,
+*               otherwise CAN_FALSE.
+*
+* Note(s)     : The driver reads into the contiguous free entries of the receive buffer. Consumed frames
+*               are removed by moving the following frames of the same read forward.
+*********************************************************************************************************
+*/
+
+#if (CANBUS_RX_HANDLER_EN > 0) && (CANBUS_RX_DEFER_EN == 0)
+static  CPU_BOOLEAN  CanBusRxBurst (CPU_INT16S    busId,
+                                    CANBUS_DATA  *bus)
+{
+    CANFRM      *frm;                                 /* Local: current CAN frame                      */
+    CPU_INT16S   n;                                   /* Local: number of read frames                  */
+    CPU_INT16S   i;                                   /* Local: loop variable                          */
+    CPU_INT16U   wr;                                  /* Local: receive buffer write counter           */
+    CPU_INT16U   pos;                                 /* Local: first free buffer entry                */
+    CPU_INT16U   free;                                /* Local: contiguous free buffer entries         */
+#if CANFRM_TIMESTAMP_EN == 1
+    CPU_INT32U   ts;                                  /* Local: reception time of the read frames      */
+#endif
+
+
+    wr = bus->BufRxWr;                                /* get write counter (only written by this ISR)  */
+    do {
+        free = (CPU_INT16U)(bus->RxMask + 1u - (CPU_INT16U)(wr - bus->BufRxRd));
+        if (free == 0u) {                             /* see, if receive buffer is full                */
+            break;
+        }
+        pos = wr & bus->RxMask;
+        if (free > (CPU_INT16U)(bus->RxMask + 1u - pos)) { /* limit to entries up to buffer end        */
+            free = (CPU_INT16U)(bus->RxMask + 1u - pos);
+        }
+#if CANFRM_TIMESTAMP_EN == 1
+        ts = CANOS_GetTimestamp();                    /* capture reception time                        */
+#endif
+        n = bus->Cfg->ReadN(bus->Dev,                 /* read pending frames from can bus interface    */
+                            (CPU_INT08U *)&bus->BufRx[pos],
+                            (CPU_INT16U)sizeof(CANFRM),
+                            free);
+        CANSetErrRegister(n);
+        if (n < 0) {                                  /* see, if driver reports an error               */
+#if CANBUS_STAT_EN > 0
+            bus->RxErr++;                             /* yes: increment driver error counter           */
+            bus->RxLost++;
+#endif
+            n = 0;
+        }
+#if CANBUS_RX_POLL_EN > 0
+        bus->RxPollCnt += (CPU_INT16U)n;              /* count frames for the receive load             */
+#endif
+        for (i = 0; i < n; i++) {                     /* process all read frames                       */
+            frm = &bus->BufRx[pos + (CPU_INT16U)i];
+#if CANFRM_TIMESTAMP_EN == 1
+            frm->Timestamp = ts;
+#endif
+            if (CanBusRxProcess(busId, bus, frm) == 0) { /* see, if frame is not consumed              */
+                if (frm != &bus->BufRx[wr & bus->RxMask]) {
+                    bus->BufRx[wr & bus->RxMask] = *frm; /* close gap of consumed frames               */
+                }
+                wr++;
+            }
+        }
+    } while ((CPU_INT16U)n == free);                  /* repeat, until device has no pending frames    */
+
+    CanBusRxPublish(busId, bus, wr);                  /* publish all accepted frames                   */
+
+    return ((free == 0u) ? CAN_TRUE : CAN_FALSE);
+}
+#endif                                                /* CANBUS_RX_DEFER_EN == 0                       */
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusRxStage()
+*
+* Description : Moves the raw received frames of the device into the staging ring of the bus and
+*               indicates them to the receive service task.
+*
+* Argument(s) : busId   Bus identifier
+*
+*               bus     Pointer to bus data
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function is called by the receive interrupt. With a driver burst read function, all
+*               pending frames are moved, otherwise a single frame is moved.
+*********************************************************************************************************
+*/
+
+#if CANBUS_RX_DEFER_EN > 0
+static  void  CanBusRxStage (CPU_INT16S    busId,
+                             CANBUS_DATA  *bus)
+{
+    CANBUS_PARA  *cfg;                                /* Local: pointer to bus configuration           */
+    CANFRM        dummyfrm;                           /* Local: discarded CAN frame                    */
+    CPU_INT16S    n;                                  /* Local: number of read frames                  */
+    CPU_INT16U    wr;                                 /* Local: staging ring write counter             */
+    CPU_INT16U    pos;                                /* Local: first free staging entry               */
+    CPU_INT16U    free;                               /* Local: contiguous free staging entries        */
+#if CANFRM_TIMESTAMP_EN == 1
+    CPU_INT16S    i;                                  /* Local: loop variable                          */
+    CPU_INT32U    ts;                                 /* Local: reception time of the read frames      */
+#endif
+
+
+    (void)busId;                                      /* prevent compiler warnings                     */
+    cfg = bus->Cfg;                                   /* set pointer to bus configuration              */
+    wr  = bus->StageWr;                               /* get write counter (only written by this ISR)  */
+    do {
+        free = (CPU_INT16U)(CANBUS_RX_STAGE_SIZE - (CPU_INT16U)(wr - bus->StageRd));
+        if (free == 0u) {                             /* see, if staging ring is full                  */
+#if CANBUS_RX_READ_ALWAYS_EN > 0
+            n = CanBusRxRead(bus, &dummyfrm);         /* read and discard frame                        */
+            CANSetErrRegister(n);
+#else
+            if (cfg->ReadN != NULL_PTR) {             /* see, if driver releases the device mailbox    */
+                (void)CanBusRxRead(bus, &dummyfrm);   /* yes: read and discard frame                   */
+            }
+#endif
+#if CANBUS_STAT_EN > 0
+            bus->RxLost++;                            /* Increment receive CAN frame lost counter      */
+#endif
+            break;
+        }
+        pos = wr & (CANBUS_RX_STAGE_SIZE - 1u);
+        if (free > (CPU_INT16U)(CANBUS_RX_STAGE_SIZE - pos)) { /* limit to entries up to ring end      */
+            free = (CPU_INT16U)(CANBUS_RX_STAGE_SIZE - pos);
+        }
+#if CANFRM_TIMESTAMP_EN == 1
+        ts = CANOS_GetTimestamp();                    /* capture reception time                        */
+#endif
+        if (cfg->ReadN != NULL_PTR) {                 /* see, if driver supports burst read            */
+            n = cfg->ReadN(bus->Dev,                  /* read pending frames from can bus interface    */
+                           (CPU_INT08U *)&bus->BufStage[pos],
+                           (CPU_INT16U)sizeof(CANFRM),
+                           free);
+        } else {
+            n = cfg->Read(bus->Dev,                   /* read can frame from can bus interface         */
+                          (void *)&bus->BufStage[pos],
+                          CANFRM_DRV_SIZE);
+            n = (n == (CPU_INT16S)CANFRM_DRV_SIZE) ? 1 : -1;
+        }
+        CANSetErrRegister(n);
+        if (n < 0) {                                  /* see, if driver reports an error               */
+#if CANBUS_STAT_EN > 0
+            bus->RxErr++;                             /* yes: increment driver error counter           */
+            bus->RxLost++;
+#endif
+            n = 0;
+        }
+#if CANBUS_RX_POLL_EN > 0
+        bus->RxPollCnt += (CPU_INT16U)n;              /* count frames for the receive load             */
+#endif
+#if CANFRM_TIMESTAMP_EN == 1
+        for (i = 0; i < n; i++) {                     /* stamp all read frames                         */
+            bus->BufStage[pos + (CPU_INT16U)i].Timestamp = ts;
+        }
+#endif
+        wr += (CPU_INT16U)n;
+    } while ((cfg->ReadN != NULL_PTR) &&              /* repeat, until device has no pending frames    */
+             ((CPU_INT16U)n == free));
+
+    if (wr != bus->StageWr) {                         /* see, if frames are staged                     */
+        CANBUS_MB();                                  /* complete entries before publishing them       */
+        bus->StageWr = wr;                            /* publish frames to service task                */
+        CANOS_PostRxService();                        /* wake up service task                          */
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusRxDrain()
+*
+* Description : Processes all staged frames of the bus and publishes the accepted frames in the receive
+*               buffer with a single update and a single post of the receive semaphore.
+*
+* Argument(s) : busId   Bus identifier
+*
+*               bus     Pointer to bus data
+*
+* Return(s)   : Number of processed frames.
+*
+* Note(s)     : This function is called by the service task. A frame, which finds the receive buffer
+*               full, is lost.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  CanBusRxDrain (CPU_INT16S    busId,
+                                   CANBUS_DATA  *bus)
+{
+    CANFRM      *frm;                                 /* Local: current staged frame                   */
+    CPU_INT16U   rd;                                  /* Local: staging ring read counter              */
+    CPU_INT16U   wr;                                  /* Local: receive buffer write counter           */
+    CPU_INT16U   num = 0u;                            /* Local: number of processed frames             */
+#if (CANBUS_STAT_EN > 0) && (CANBUS_RX_POLICY_EN == 0)
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+#endif
+
+
+    rd = bus->StageRd;                                /* get read counter (only written by this task)  */
+    wr = bus->BufRxWr;                                /* get write counter (only written by this task) */
+    while (rd != bus->StageWr) {                      /* see, if staging ring contains frames          */
+        CANBUS_MB();                                  /* read entry after published write counter      */
+        frm = &bus->BufStage[rd & (CANBUS_RX_STAGE_SIZE - 1u)];
+        if (CanBusRxProcess(busId, bus, frm) == 0) {  /* see, if frame is not consumed                 */
+                                                      /* see, if no buffer overrun occurs              */
+            if ((CPU_INT16U)(wr - bus->BufRxRd) <= bus->RxMask) {
+                bus->BufRx[wr & bus->RxMask] = *frm;  /* copy frame to receive buffer                  */
+                wr++;
+            }
+#if CANBUS_RX_POLICY_EN > 0
+            else {                                    /* otherwise: apply overflow policy of the bus   */
+                CanBusRxPublish(busId, bus, wr);      /* policy works on the published frames          */
+                CanBusRxShed(busId, bus, frm);
+                wr = bus->BufRxWr;
+            }
+#elif CANBUS_STAT_EN > 0
+            else {
+                CPU_CRITICAL_ENTER();                 /* counter is shared with the receive interrupt  */
+                bus->RxLost++;                        /* Increment receive CAN frame lost counter      */
+                CPU_CRITICAL_EXIT();
+            }
+#endif
+        }
+        rd++;
+        num++;
+        CANBUS_MB();                                  /* complete copy before releasing the entry      */
+        bus->StageRd = rd;                            /* release staging entry to interrupt            */
+    }
+
+    CanBusRxPublish(busId, bus, wr);                  /* publish all accepted frames                   */
+    return (num);
+}
+#endif                                                /* CANBUS_RX_DEFER_EN > 0                        */
+
+
+/*
+*********************************************************************************************************
+*                                            CanBusInit()
+*
+* Description : Initializes the CAN bus management. This includes the creation of all needed OS-service
+*               components. The needed components are dependened on the configuration of the CAN bus 
+*               management mode.
+*
+* Argument(s) : arg     Not used
+*
+* Return(s)   : Errorcode, if an error is detected, otherwise CAN_ERR_NONE for successful initialization.
+*
+* Note(s)     : This function has the standard device driver interface, decribed in the porting chapter
+*               of the user manual. This allows the CAN bus handling via the standard device driver
+*               interface.
+*********************************************************************************************************
+*/
+
+CPU_INT16S  CanBusInit (CPU_INT32U  arg)
+{
+    CANBUS_DATA  *bus    = &(CanBusTbl[0]);           /* Local: pointer to bus #1                      */
+    CPU_INT32U    i;                                  /* Local: loop variable                          */
+    CPU_INT16S    err;                                /* Local: errorcode of CANOS initialization      */
+    CPU_INT16S    result = CAN_ERR_NONE;              /* Local: function result                        */
+
+
+   (void)arg;                                         /* unused; prevent compiler warning              */
+
+    if (CanBus_IsInitialized == 0u) {
+        err = CANOS_Init();                           /* Initialize OS specific services               */
+        if (err != CAN_ERR_NONE) {                    /* See, if services are initialized              */
+            can_errnum = err;
+            return err;                               /* set function result to 'error'                */
+        } else {                                      /* otherwise, build free list:                   */
+            for (i=0u; i<CANBUS_N; i++) {             /* loop through all CAN busses in table          */
+                bus->RxTimeout = 0u;                  /* set timeout to 0 (Rx in blocking mode)        */
+                bus->TxTimeout = 0u;                  /* set timeout to 0 (Tx in blocking mode)        */
+                bus->Dev       = 0;                   /* clear device identifier                       */
+                bus->Cfg       = NULL_PTR;            /* clear pointer to bus configuration            */
+                bus->BufRx     = NULL_PTR;            /* no receive buffer linked (see CanBusEnable)   */
+                bus->RxMask    = 0u;
+                bus->BufTx     = NULL_PTR;            /* no transmit buffer linked (see CanBusEnable)  */
+                bus->TxMask    = 0u;
+                bus->BufRxRd   = 0u;                  /* set receive read location to buffer           */
+                bus->BufRxWr   = 0u;                  /* set receive write location to buffer          */
+                bus->RxPeek    = 0u;                  /* no peeked receive frames                      */
+#if CANBUS_RX_POLICY_EN > 0
+                bus->RxPolicy  = CANBUS_RX_DROP_NEWEST; /* lose received frames on full queue          */
+#endif
+#if CANBUS_RX_COALESCE_EN > 0
+                bus->RxCoalFrames = 0u;               /* signal each received frame                    */
+                bus->RxCoalTime   = 0u;
+                bus->RxUnposted   = 0u;
+                bus->RxFirst      = 0u;
+#endif
+#if CANBUS_RX_POLL_EN > 0
+                bus->RxPollOn     = 0u;               /* bus is never polled                           */
+                bus->RxPollOff    = 0u;
+                bus->RxPollPeriod = 1u;
+                bus->RxPollTime   = 0u;
+                bus->RxPollCnt    = 0u;
+                bus->RxPolling    = CAN_FALSE;
+#endif
+#if CANBUS_RX_MSG_EN > 0
+                bus->RxMsg        = CAN_FALSE;        /* store all received frames                     */
+#endif
+                bus->BufTxRd   = 0u;                  /* set transmit read location to buffer          */
+                bus->BufTxWr   = 0u;                  /* set transmit write location to buffer         */
+                bus->TxReserved = 0u;                 /* no reserved transmit frames                   */
+#if CANBUS_TX_PRIO_EN > 0
+                bus->TxSeq     = 0u;                  /* reset transmit sequence counter               */
+                bus->TxResBase = 0u;
+#endif
+#if CANBUS_FILTER_EN > 0
+                bus->FilterOn  = CAN_FALSE;           /* accept all frames                             */
+                CanBusFilterClear(bus);
+#endif
+#if CANBUS_SUB_EN > 0
+                bus->SubNum    = 0u;                  /* no receive subscribers                        */
+#endif
+#if CANBUS_GW_EN > 0
+                bus->RouteNum  = 0u;                  /* no gateway routes                             */
+                bus->GwRd      = 0u;                  /* no forwarded frames                           */
+                bus->GwWr      = 0u;
+#endif
+#if CANBUS_STAT_EN > 0
+                bus->RxLost    = 0u;                  /* clear counter for lost RX frames              */
+                bus->TxLost    = 0u;                  /* clear counter for lost TX frames              */
+                bus->RxOk      = 0u;                  /* clear counter for received RX frames          */
+                bus->TxOk      = 0u;                  /* clear counter for transmitted TX frames       */
+                bus->RxErr     = 0u;                  /* clear counter for driver read errors          */
+                bus->TxErr     = 0u;                  /* clear counter for driver write errors         */
+                bus->RxBits    = 0u;                  /* clear bus load measurement                    */
+                bus->TxBits    = 0u;
+                bus->LoadTime  = 0u;
+                bus->LoadBits  = 0u;
+                bus->RxHwm     = 0u;                  /* clear queue high-water marks                  */
+                bus->TxHwm     = 0u;
+#if CANBUS_RX_POLICY_EN > 0
+                bus->RxDropNewest = 0u;               /* clear receive overflow policy counters        */
+                bus->RxDropOldest = 0u;
+                bus->RxEvicted    = 0u;
+#endif
+#if CANBUS_RX_POLL_EN > 0
+                bus->RxPollEnter  = 0u;               /* clear receive polling switch counters         */
+                bus->RxPollLeave  = 0u;
+#endif
+#if CANBUS_GW_EN > 0
+                bus->GwFwd        = 0u;               /* clear gateway counters                        */
+                bus->GwLost       = 0u;
+                bus->GwDlcErr     = 0u;
+#endif
+#endif                                                /* CANBUS_STAT_EN > 0 */
+
+                bus++;                                /* lint !e960 switch bus to next bus in table    */
+            }
+#if CANBUS_SUB_EN > 0
+            for (i=0u; i<CANBUS_SUB_N; i++) {         /* loop through all receive subscribers          */
+                CanBusSubTbl[i].BusId = -1;           /* mark subscriber unused                        */
+            }
+#endif
+#if CANBUS_GW_EN > 0
+            for (i=0u; i<CANBUS_GW_N; i++) {          /* loop through all gateway routes               */
+                CanBusGwTbl[i].BusId = -1;            /* mark route unused                             */
+                CanBusGwTbl[i].Route = NULL_PTR;
+            }
+#endif
+            CanBus_IsInitialized = 1u;                /* mark bus initialized                          */
+        }
+    }
+
+    return result;                                    /* return function result                        */
+}
+
+
+/*
+*********************************************************************************************************
+*                                            CanBusIoCtl()
+*
+* Description : This function performs a special action on the opened device. The function code func 
+*               defines what the caller wants to do.
+*
+* Argument(s) : busId   Bus identifier
+*
+*               func    function code
+*
+*                           CANBUS_RESET             Reinitialize the CAN bus; all pending transmissions
+*                                                    will be canceled and received messages will be lost.
+*
+*                           CANBUS_FLUSH_TX          Remove all entries out of the TX queue
+*
+*                           CANBUS_FLUSH_RX          Remove all entries out of the RX queue
+*
+*                           CANBUS_SET_TX_TIMEOUT    Set TX timeout value
+*
+*                           CANBUS_SET_RX_TIMEOUT    Set RX timeout value
+*
+*                           CANBUS_GET_STAT          Get snapshot of the bus statistics
+*
+*                           CANBUS_SET_RX_POLICY     Set RX overflow policy
+*
+*                           CANBUS_SET_RX_COALESCE   Set RX signal coalescing
+*
+*                           CANBUS_SET_RX_POLL       Set RX polling thresholds
+*
+*                           CANBUS_SET_RX_MSG        Set RX unpacking into CAN messages
+*
+*               argp    Pointer to argument, specific to the function code
+*
+* Return(s)   : Errorcode, if an error is detected, otherwise CAN_ERR_NONE for successful operation.
+*
+* Note(s)     : This function has the standard device driver interface, decribed in the porting chapter
+*               of the user manual. This allows the CAN bus handling via the standard device driver
+*               interface.
+*********************************************************************************************************
+*/
+
+CPU_INT16S  CanBusIoCtl (CPU_INT16S   busId,
+                         CPU_INT16U   func,
+                         void        *argp)
+{
+    CPU_INT16S    result = CAN_ERR_UNKNOWN;           /* Local: function result                        */
+    CANBUS_DATA  *bus;                                /* Local: pointer to bus data                    */
+    CANBUS_PARA  *cfg;                                /* Local: pointer to bus configuration           */
+    CPU_INT16U    drvfunc;                            /* Local: translated driver function code        */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+#if CANBUS_ARG_CHK_EN > 0
+                                                      /* is busId out of range?                        */
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) {
+        can_errnum = CAN_ERR_BUSID;
+        return CAN_ERR_BUSID;
+    }
+    if (CanBusTbl[busId].Cfg == NULL_PTR) {           /* is bus not enabled?                           */
+        can_errnum = CAN_ERR_NULLPTR;
+        return CAN_ERR_NULLPTR;
+    }
+#endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
+
+    bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
+    cfg = bus->Cfg;                                   /* yes: set pointer to bus configuration         */
+
+    switch (func) {                                   /* Switch to selected function code              */
+                                                      /*-----------------------------------------------*/
+        case CANBUS_RESET:                            /*                 Reset CAN bus                 */
+                                                      /*-----------------------------------------------*/
+            result = cfg->Close(bus->Dev);            /* Close opened CAN bus                          */
+            if (result != CAN_ERR_NONE) {
+                break;
+            }
+#if CANBUS_TX_CONFIRM_EN > 0
+            CPU_CRITICAL_ENTER();                     /* disable all interrupts                        */
+            CanBusTxAbort(busId, bus, CAN_TRUE);      /* frames in the device are lost                 */
+            CPU_CRITICAL_EXIT();                      /* enable all interrupts                         */
+#endif
+            result = cfg->Init(cfg->DriverDevName);   /* Reinitialize the CAN bus                      */
+            if (result != CAN_ERR_NONE) {
+                break;
+            }
+                                                      /* Open configured can bus                       */
+            bus->Dev = cfg->Open((CPU_INT16S)cfg->BusNodeName,
+                                 cfg->DriverDevName,
+                                 DEV_RW);
+            if (bus->Dev >= 0) {                      /* See, if bus can be opened                     */
+                drvfunc = cfg->Io[CAN_SET_BAUDRATE];
+                result = cfg->IoCtl(bus->Dev, drvfunc,/* Set can bus timing with:                      */
+                           (void*)&(cfg->Baudrate));  /*   configured baudrate                         */
+                if (result != CAN_ERR_NONE) {
+                    break;
+                }
+                                                      /* see, if Ext.Ids on receiver are enabled       */
+                if (cfg->Extended == CAN_TRUE) {
+                    result = cfg->IoCtl(bus->Dev,     /* Set receiver to extended format ids           */
+                                     cfg->Io[CAN_RX_EXTENDED],
+                                     0);
+                    if (result != CAN_ERR_NONE) {
+                        break;
+                    }
+                }
+                result = cfg->IoCtl(bus->Dev,         /* Enable can bus communication                  */
+                                 cfg->Io[CAN_START], 0);
+                if (result != CAN_ERR_NONE) {
+                    break;
+                }
+                result = CAN_ERR_NONE;                /* successfull can bus initialisation            */
+            }
+            else {
+                result = CAN_ERR_OPEN;
+            }
+            break;
+
+                                                      /*-----------------------------------------------*/
+        case CANBUS_FLUSH_TX:                         /*                Flush tx queue                 */
+                                                      /*-----------------------------------------------*/
+            CPU_CRITICAL_ENTER();                     /* disable all interrupts                        */
+            bus->BufTxRd = bus->BufTxWr;              /* buffer is empty when read = write ptr         */
+            bus->TxReserved = 0u;                     /* reserved entries are released, too            */
+#if CANBUS_GW_EN > 0
+            bus->GwRd = bus->GwWr;                    /* forwarded frames are removed, too             */
+#endif
+            CANOS_ResetTx(busId, (CPU_INT16U)(bus->TxMask + 1u));
+#if CANBUS_TX_CONFIRM_EN > 0
+            CanBusTxAbort(busId, bus, CAN_FALSE);     /* abort confirmations of removed frames         */
+#endif
+            CPU_CRITICAL_EXIT();                      /* enable all interrupts                         */
+            result       = CAN_ERR_NONE;              /* indicate successful operation                 */
+            break;
+
+                                                      /*-----------------------------------------------*/
+        case CANBUS_FLUSH_RX:                         /*                Flush rx queue                 */
+                                                      /*-----------------------------------------------*/
+            CPU_CRITICAL_ENTER();                     /* disable all interrupts                        */
+            bus->BufRxRd = bus->BufRxWr;              /* buffer is empty when read = write ptr         */
+            bus->RxPeek  = 0u;                        /* peeked frames are removed, too                */
+#if CANBUS_RX_COALESCE_EN > 0
+            bus->RxUnposted = 0u;                     /* coalesced frames are removed, too             */
+#endif
+            CANOS_ResetRx(busId);
+            CPU_CRITICAL_EXIT();                      /* enable all interrupts                         */
+            result       = CAN_ERR_NONE;              /* indicate successful operation                 */
+            break;
+
+                                                      /*-----------------------------------------------*/
+        case CANBUS_SET_RX_TIMEOUT:                   /*                Set RX timeout                 */
+                                                      /*-----------------------------------------------*/
+            if (argp != NULL_PTR) {                   /* see, if argument pointer is valid             */
+                bus->RxTimeout = *(CPU_INT16U*)argp;  /* set new timeout value                         */
+                result = CAN_ERR_NONE;                /* indicate successful operation                 */
+            }
+            else {
+                result = CAN_ERR_NULLPTR;             /* indicate an error                             */
+            }
+            break;
+
+                                                      /*-----------------------------------------------*/
+        case CANBUS_SET_TX_TIMEOUT:                   /*                Set TX timeout                 */
+                                                      /*-----------------------------------------------*/
+            if (argp != NULL_PTR) {                   /* see, if argument pointer is valid             */
+                bus->TxTimeout = *(CPU_INT16U*)argp;  /* set new timeout value                         */
+                result = CAN_ERR_NONE;                /* indicate successful operation                 */
+            }
+            else {
+                result = CAN_ERR_NULLPTR;             /* indicate an error                             */
+            }
+            break;
+
+#if CANBUS_FILTER_EN > 0
+                                                      /*-----------------------------------------------*/
+        case CANBUS_SET_FILTER:                       /*          Enable/disable acceptance filter     */
+                                                      /*-----------------------------------------------*/
+            if (argp != NULL_PTR) {                   /* see, if argument pointer is valid             */
+                bus->FilterOn = *(CPU_BOOLEAN*)argp;  /* set new filter state                          */
+                result = CAN_ERR_NONE;                /* indicate successful operation                 */
+            }
+            else {
+                result = CAN_ERR_NULLPTR;             /* indicate an error                             */
+            }
+            break;
+
+                                                      /*-----------------------------------------------*/
+        case CANBUS_FILTER_ADD:                       /*          Add identifier to filter             */
+        case CANBUS_FILTER_REMOVE:                    /*          Remove identifier from filter        */
+                                                      /*-----------------------------------------------*/
+            if (argp != NULL_PTR) {                   /* see, if argument pointer is valid             */
+                result = CanBusFilterSet(bus,
+                                         *(CPU_INT32U*)argp,
+                                         (func == CANBUS_FILTER_ADD) ? CAN_TRUE : CAN_FALSE);
+            }
+            else {
+                result = CAN_ERR_NULLPTR;             /* indicate an error                             */
+            }
+            break;
+
+                                                      /*-----------------------------------------------*/
+        case CANBUS_FILTER_CLEAR:                     /*          Remove all identifiers from filter   */
+                                                      /*-----------------------------------------------*/
+            CanBusFilterClear(bus);                   /* remove all identifiers                        */
+            result = CAN_ERR_NONE;                    /* indicate successful operation                 */
+            break;
+#endif                                                /* CANBUS_FILTER_EN > 0                          */
+
+#if CANBUS_STAT_EN > 0
+                                                      /*-----------------------------------------------*/
+        case CANBUS_GET_STAT:                         /*          Get snapshot of bus statistics       */
+                                                      /*-----------------------------------------------*/
+            if (argp != NULL_PTR) {                   /* see, if argument pointer is valid             */
+                CanBusStatGet(bus, (CANBUS_STAT*)argp);
+                result = CAN_ERR_NONE;                /* indicate successful operation                 */
+            }
+            else {
+                result = CAN_ERR_NULLPTR;             /* indicate an error                             */
+            }
+            break;
+#endif                                                /* CANBUS_STAT_EN > 0                            */
+
+#if CANBUS_RX_POLICY_EN > 0
+                                                      /*-----------------------------------------------*/
+        case CANBUS_SET_RX_POLICY:                    /*          Set receive overflow policy          */
+                                                      /*-----------------------------------------------*/
+            if (argp == NULL_PTR) {                   /* see, if argument pointer is invalid           */
+                result = CAN_ERR_NULLPTR;             /* indicate an error                             */
+            } else if (*(CPU_INT08U*)argp > CANBUS_RX_EVICT_PRIO) {
+                result = CAN_ERR_IOCTRLFUNC;          /* indicate an unknown policy                    */
+            } else {
+                bus->RxPolicy = *(CPU_INT08U*)argp;   /* set new policy                                */
+                result = CAN_ERR_NONE;                /* indicate successful operation                 */
+            }
+            break;
+#endif                                                /* CANBUS_RX_POLICY_EN > 0                       */
+
+#if CANBUS_RX_COALESCE_EN > 0
+                                                      /*-----------------------------------------------*/
+        case CANBUS_SET_RX_COALESCE:                  /*          Set receive signal coalescing        */
+                                                      /*-----------------------------------------------*/
+            if (argp == NULL_PTR) {                   /* see, if argument pointer is invalid           */
+                result = CAN_ERR_NULLPTR;             /* indicate an error                             */
+            } else if (((CANBUS_COALESCE*)argp)->Frames > (CPU_INT16U)(bus->RxMask + 1u)) {
+                result = CAN_ERR_BUFFSIZE;            /* indicate more frames than the queue size      */
+            } else {
+                CPU_CRITICAL_ENTER();                 /* settings are used by the receive interrupt    */
+                bus->RxCoalFrames = ((CANBUS_COALESCE*)argp)->Frames;
+                bus->RxCoalTime   = (CPU_INT32U)(((CPU_INT64U)((CANBUS_COALESCE*)argp)->Time *
+                                                 CANOS_TICK_RATE_HZ + 999999u) / 1000000u);
+                CPU_CRITICAL_EXIT();
+                CanBusRxFlush(busId, bus);            /* signal frames of previous settings            */
+                result = CAN_ERR_NONE;                /* indicate successful operation                 */
+            }
+            break;
+#endif                                                /* CANBUS_RX_COALESCE_EN > 0                     */
+
+#if CANBUS_RX_POLL_EN > 0
+                                                      /*-----------------------------------------------*/
+        case CANBUS_SET_RX_POLL:                      /*          Set receive polling thresholds       */
+                                                      /*-----------------------------------------------*/
+            if (argp == NULL_PTR) {                   /* see, if argument pointer is invalid           */
+                result = CAN_ERR_NULLPTR;             /* indicate an error                             */
+            } else if ((((CANBUS_POLL*)argp)->Enter != 0u) &&
+                       ((cfg->ReadN == NULL_PTR) || (cfg->RxIrq == NULL_PTR) ||
+                        (((CANBUS_POLL*)argp)->Leave > ((CANBUS_POLL*)argp)->Enter))) {
+                result = CAN_ERR_IOCTRLFUNC;          /* indicate driver without polling support       */
+            } else {                                  /* a polled bus switches back in CanBusRxPoll()  */
+                CPU_CRITICAL_ENTER();                 /* settings are used by the receive interrupt    */
+                bus->RxPollOn     = ((CANBUS_POLL*)argp)->Enter;
+                bus->RxPollOff    = ((CANBUS_POLL*)argp)->Leave;
+                bus->RxPollPeriod = ((CANBUS_POLL*)argp)->Period;
+                if (bus->RxPollPeriod == 0u) {
+                    bus->RxPollPeriod = 1u;
+                }
+                CPU_CRITICAL_EXIT();
+                result = CAN_ERR_NONE;                /* indicate successful operation                 */
+            }
+            break;
+#endif                                                /* CANBUS_RX_POLL_EN > 0                         */
+
+#if CANBUS_RX_MSG_EN > 0
+                                                      /*-----------------------------------------------*/
+        case CANBUS_SET_RX_MSG:                       /*          Set receive message unpacking        */
+                                                      /*-----------------------------------------------*/
+            if (argp == NULL_PTR) {                   /* see, if argument pointer is invalid           */
+                result = CAN_ERR_NULLPTR;             /* indicate an error                             */
+            } else {
+                if (*(CPU_BOOLEAN*)argp != CAN_FALSE) {
+                    bus->RxMsg = CAN_TRUE;            /* unpack frames of CAN messages                 */
+                } else {
+                    bus->RxMsg = CAN_FALSE;           /* store all frames in receive queue             */
+                }
+                result = CAN_ERR_NONE;                /* indicate successful operation                 */
+            }
+            break;
+#endif                                                /* CANBUS_RX_MSG_EN > 0                          */
+
+                                                      /*-----------------------------------------------*/
+        default:                                      /*        Unsupported function code              */
+            result = CAN_ERR_IOCTRLFUNC;              /* indicate successful operation                 */
+                                                      /*-----------------------------------------------*/
+            break;                                    /* don't indicate successful operation           */
+    }                                                 /*-----------------------------------------------*/
+
+    CANSetErrRegister(result);
+
+    return(result);                                   /* return function result                        */
+}
+
+
+/*
+*********************************************************************************************************
+*                                            CanBusRead()
+*
+* Description : This function is called by the application to obtain a frame from the opened CAN bus. The
+*               function will wait for a frame to be received on the CAN bus or until the configured
+*               timeout is reached.
+*
+* Argument(s) : busId     Bus identifier
+*
+*               buffer    Pointer to CAN frame in format CANFRM
+*
+*               size      Size of CAN frame
+*
+* Return(s)   : Errorcode CAN_ERR_UNKNOWN, if an error is detected, otherwise size of can frame for
+*               successful reading.
+*
+* Note(s)     : This function has the standard device driver interface, decribed in the porting chapter
+*               of the user manual. This allows the CAN bus handling via the standard device driver
+*               interface.
+*
+*               The receive buffer is a single consumer queue: the receive functions of a bus shall be
+*               called by a single task.
+*********************************************************************************************************
+*/
+
+CPU_INT16S  CanBusRead (CPU_INT16S   busId,
+                        void        *buffer,
+                        CPU_INT16U   size)
+{
+    CANFRM       *frm;                                /* Local: Pointer to received can frame          */
+    CANBUS_DATA  *bus;                                /* Local: Pointer to bus data                    */
+    CPU_INT16S    result = CAN_ERR_UNKNOWN;           /* Local: Function result                        */
+    CPU_INT16U    rd;                                 /* Local: receive buffer read counter            */
+    CPU_INT08U    frx;                                /* Local: indication for 'frame received'        */
+#if CANBUS_RX_POLICY_EN > 0
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+#endif
+
+
+#if CANBUS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return (CAN_ERR_BUSID);
+    }
+    if (buffer == NULL_PTR) {                         /* does buffer points to valid address ?         */
+        can_errnum = CAN_ERR_NULLPTR;
+        return (CAN_ERR_NULLPTR);
+    }
+    if (size != sizeof(CANFRM)) {                     /* is size invalid?                              */
+        can_errnum = CAN_ERR_FRMSIZE;
+        return (CAN_ERR_FRMSIZE);
+    }
+#endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
+
+    bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
+#if CANBUS_RX_COALESCE_EN > 0
+    if (bus->RxUnposted != 0u) {                      /* see, if frames are coalesced                  */
+        CanBusRxFlush(busId, bus);                    /* yes: running reader gets them without delay   */
+    }
+#endif
+    frx = CANOS_PendRxFrame (bus->RxTimeout, busId);  /* wait for a CAN frame from RX-ISR              */
+    if (frx != 0u) {                                  /* See if frame received within timeout          */
+#if CANBUS_RX_POLICY_EN > 0
+        CPU_CRITICAL_ENTER();                         /* overflow policy may remove the oldest frame   */
+#endif
+        rd  = bus->BufRxRd;                           /* get read counter                              */
+        frm = &bus->BufRx[rd & bus->RxMask];          /* get next read location from ringbuffer        */
+                                                      /* copy can frame to buffer                      */
+        CanBusCpy(buffer,(void *)frm, (CPU_INT08U)sizeof(CANFRM));
+        CANBUS_MB();                                  /* complete copy before releasing the entry      */
+        bus->BufRxRd = rd + 1u;                       /* release entry to RX-ISR                       */
+#if CANBUS_RX_POLICY_EN > 0
+        CPU_CRITICAL_EXIT();
+#endif
+        result = (CPU_INT16S)sizeof(CANFRM);          /* set received byte counter                     */
+    }
+
+#if CANBUS_STAT_EN > 0
+    if (result == (CPU_INT16S)sizeof(CANFRM)) {       /* see, if no error occurs                       */
+        bus->RxOk++;                                  /* increment receive counter                     */
+    }                                                 /* Failure: we can't get a memory partition      */
+#endif                                                /* CANBUS_STAT_EN > 0                            */
+
+    CANSetErrRegister(result);
+
+    return (result);                                  /* return function result                        */
+}
+
+
+/*
+*********************************************************************************************************
+*                                            CanBusReadN()
+*
+* Description : This function is called by the application to obtain multiple frames from the opened CAN
+*               bus with a single call. The function will wait for at least one frame to be received on
+*               the CAN bus or until the given timeout is reached. All frames, which are available in the
+*               receive buffer at this time, are copied to the given frame array (up to the given maximum
+*               number of frames).
+*
+* Argument(s) : busId     Bus identifier
+*
+*               frames    Pointer to array of CAN frames in format CANFRM
+*
+*               max       Maximal number of CAN frames, which fits into the frame array
+*
+*               timeout   Timeout in OS time ticks (0 = wait forever)
+*
+* Return(s)   : Errorcode, if an error is detected, otherwise the number of received CAN frames (0 if no
+*               frame is received within the timeout).
+*
+* Note(s)     : The maximal number of frames, which can be received with a single call, is limited to the
+*               receive queue size of the bus and to 32767.
+*********************************************************************************************************
+*/
+
+CPU_INT16S  CanBusReadN (CPU_INT16S   busId,
+                         CANFRM      *frames,
+                         CPU_INT16U   max,
+                         CPU_INT16U   timeout)
+{
+    CANBUS_DATA  *bus;                                /* Local: Pointer to bus data                    */
+    CPU_INT16U    rd;                                 /* Local: receive buffer read counter            */
+    CPU_INT16U    num;                                /* Local: number of received frames              */
+    CPU_INT16U    i;                                  /* Local: loop variable                          */
+#if CANBUS_RX_POLICY_EN > 0
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+#endif
+
+
+#if CANBUS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return (CAN_ERR_BUSID);
+    }
+    if (frames == NULL_PTR) {                         /* does frames points to valid address ?         */
+        can_errnum = CAN_ERR_NULLPTR;
+        return (CAN_ERR_NULLPTR);
+    }
+#endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
+
+    bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
+    if (max > (CPU_INT16U)(bus->RxMask + 1u)) {       /* limit to the receive buffer size              */
+        max = (CPU_INT16U)(bus->RxMask + 1u);
+    }
+    if (max > CANBUS_NUM_MAX) {                       /* limit to the range of the function result     */
+        max = CANBUS_NUM_MAX;
+    }
+#if CANBUS_RX_COALESCE_EN > 0
+    if (bus->RxUnposted != 0u) {                      /* see, if frames are coalesced                  */
+        CanBusRxFlush(busId, bus);                    /* yes: running reader gets them without delay   */
+    }
+#endif
+    num = CANOS_PendRxFrameN(timeout, busId, max);    /* wait for CAN frames from RX-ISR               */
+    if (num != 0u) {                                  /* See if frames received within timeout         */
+#if CANBUS_RX_POLICY_EN > 0
+        for (i = 0u; i < num; i++) {                  /* copy and release frame by frame, because      */
+            CPU_CRITICAL_ENTER();                     /* overflow policy may remove the oldest frame   */
+            rd = bus->BufRxRd;
+            frames[i] = bus->BufRx[rd & bus->RxMask];
+            bus->BufRxRd = rd + 1u;                   /* release entry to RX-ISR                       */
+            CPU_CRITICAL_EXIT();
+        }
+#else
+        rd = bus->BufRxRd;                            /* get read counter (only written by this task)  */
+        for (i = 0u; i < num; i++) {                  /* copy all received frames to the frame array   */
+            frames[i] = bus->BufRx[(CPU_INT16U)(rd + i) & bus->RxMask];
+        }
+        CANBUS_MB();                                  /* complete copy before releasing the entries    */
+        bus->BufRxRd = rd + num;                      /* release entries to RX-ISR                     */
+#endif
+
+#if CANBUS_STAT_EN > 0
+        bus->RxOk += num;                             /* increment receive counter                     */
+#endif                                                /* CANBUS_STAT_EN > 0                            */
+    }
+
+    return ((CPU_INT16S)num);                         /* return number of received frames              */
+}
+
+
+/*
+*********************************************************************************************************
+*                                            CanBusRxPeek()
+*
+* Description : This function is called by the application to access received frames directly within the
+*               receive buffer without copying them. If no received frame is handed out to the application,
+*               the function will wait for at least one frame to be received on the CAN bus or until the
+*               configured timeout is reached. The frames stay in the receive buffer until they are
+*               released with CanBusRxCommit().
+*
+* Argument(s) : busId     Bus identifier
+*
+*               frames    Pointer to the location, which receives the pointer to the first frame
+*
+* Return(s)   : Errorcode, if an error is detected, otherwise the number of frames, which are located in
+*               sequence at the returned frame pointer (0 if no frame is received within the timeout).
+*
+* Note(s)     : The returned frames are read-only. Subsequent calls without a commit return the same
+*               frames; frames received in the meantime are handed out after the commit of all handed out
+*               frames. The frame sequence ends at the end of the receive buffer and is limited to 32767
+*               frames.
+*********************************************************************************************************
+*/
+
+CPU_INT16S  CanBusRxPeek (CPU_INT16S       busId,
+                          const CANFRM   **frames)
+{
+    CANBUS_DATA  *bus;                                /* Local: Pointer to bus data                    */
+    CPU_INT16U    rd;                                 /* Local: receive buffer read counter            */
+    CPU_INT16U    num = 0u;                           /* Local: number of frames                       */
+#if CANBUS_RX_POLICY_EN > 0
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+#endif
+
+
+#if CANBUS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return (CAN_ERR_BUSID);
+    }
+    if (frames == NULL_PTR) {                         /* does frames points to valid address ?         */
+        can_errnum = CAN_ERR_NULLPTR;
+        return (CAN_ERR_NULLPTR);
+    }
+#endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
+
+    bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
+    if (bus->RxPeek == 0u) {                          /* see, if no frame is handed out                */
+#if CANBUS_RX_COALESCE_EN > 0
+        if (bus->RxUnposted != 0u) {                  /* see, if frames are coalesced                  */
+            CanBusRxFlush(busId, bus);                /* yes: running reader gets them without delay   */
+        }
+#endif
+        rd  = bus->BufRxRd;                           /* yes: wait for CAN frames up to buffer end     */
+        num = (CPU_INT16U)(bus->RxMask + 1u) - (rd & bus->RxMask);
+        num = CANOS_PendRxFrameN(bus->RxTimeout, busId, num);
+    }
+#if CANBUS_RX_POLICY_EN > 0
+    CPU_CRITICAL_ENTER();                             /* overflow policy may remove the oldest frame   */
+#endif
+    bus->RxPeek += num;                               /* hand out the new frames                       */
+    rd  = bus->BufRxRd;                               /* get read counter                              */
+    num = (CPU_INT16U)(bus->RxMask + 1u) - (rd & bus->RxMask);
+    if (num > bus->RxPeek) {                          /* limit to the handed out frames                */
+        num = bus->RxPeek;
+    }
+#if CANBUS_RX_POLICY_EN > 0
+    CPU_CRITICAL_EXIT();
+#endif
+    if (num > CANBUS_NUM_MAX) {                       /* limit to the range of the result              */
+        num = CANBUS_NUM_MAX;
+    }
+    *frames = &bus->BufRx[rd & bus->RxMask];          /* set pointer to first handed out frame         */
+
+    return ((CPU_INT16S)num);                         /* return number of handed out frames            */
+}
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusRxCommit()
+*
+* Description : This function is called by the application to release frames, which are accessed with
+*               CanBusRxPeek(), back to the receive buffer.
+*
+* Argument(s) : busId     Bus identifier
+*
+*               num       Number of frames, which shall be released
+*
+* Return(s)   : Errorcode, if an error is detected, otherwise CAN_ERR_NONE for successful operation.
+*
+* Note(s)     : The number of frames must not exceed the number of frames, which are returned by the
+*               latest call of CanBusRxPeek().
+*********************************************************************************************************
+*/
+
+CPU_INT16S  CanBusRxCommit (CPU_INT16S   busId,
+                            CPU_INT16U   num)
+{
+    CANBUS_DATA  *bus;                                /* Local: Pointer to bus data                    */
+#if CANBUS_RX_POLICY_EN > 0
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+#endif
+
+
+#if CANBUS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return (CAN_ERR_BUSID);
+    }
+#endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
+
+    bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
+    if (num > bus->RxPeek) {                          /* see, if more frames than handed out           */
+        can_errnum = CAN_ERR_BUFFSIZE;
+        return (CAN_ERR_BUFFSIZE);
+    }
+    CANBUS_MB();                                      /* complete access before releasing the entries  */
+#if CANBUS_RX_POLICY_EN > 0
+    CPU_CRITICAL_ENTER();                             /* overflow policy reads both counters           */
+#endif
+    bus->BufRxRd += num;                              /* release entries to RX-ISR                     */
+    bus->RxPeek  -= num;
+#if CANBUS_RX_POLICY_EN > 0
+    CPU_CRITICAL_EXIT();
+#endif
+
+#if CANBUS_STAT_EN > 0
+    bus->RxOk    += num;                              /* increment receive counter                     */
+#endif                                                /* CANBUS_STAT_EN > 0                            */
+
+    return (CAN_ERR_NONE);                            /* return function result                        */
+}
+
+
+/*
+*********************************************************************************************************
+*                                            CanBusWrite()
+*
+* Description : This function is called by the application to send a CAN frame on the opened CAN bus. The
+*               function will wait for the buffer to empty out if the buffer is full. The function returns
+*               to the application if the buffer doesn't empty within the configured timeout. A timeout
+*               value of 0 (standard) means, that the calling function will wait forever for the buffer
+*               to empty out.
+*
+* Argument(s) : busId     Bus identifier
+*
+*               buffer    Pointer to CAN frame in format CANFRM
+*
+*               size      Size of CAN frame
+*
+* Return(s)   : Errorcode CAN_ERR_UNKNOWN, if an error is detected, otherwise size of can frame for
+*               successful writing.
+*
+* Note(s)     : This function has the standard device driver interface, decribed in the porting chapter
+*               of the user manual. This allows the CAN bus handling via the standard device driver
+*               interface.
+*
+*               The transmit buffer is a single producer queue: the transmit functions of a bus shall be
+*               called by a single task.
+*********************************************************************************************************
+*/
+
+CPU_INT16S  CanBusWrite (CPU_INT16S   busId,
+                         void        *buffer,
+                         CPU_INT16U   size)
+{
+#if (CANBUS_TX_HANDLER_EN > 0) && (CANBUS_TX_PRIO_EN == 0)
+    CANFRM       *frm;                                /* Local: current CAN frame                      */
+#endif
+    CANBUS_PARA  *cfg;                                /* Local: Pointer to bus configuration           */
+    CANBUS_DATA  *bus;                                /* Local: Pointer to bus data                    */
+    CPU_INT16S    result = CAN_ERR_NONE;              /* Local: Function result                        */
+    CPU_BOOLEAN   ready;                              /* Local: device is ready for transmission       */
+    CPU_INT16U    wr;                                 /* Local: transmit buffer write counter          */
+#if CANBUS_TX_HANDLER_EN > 0
+    CPU_INT16U    sent = 0u;                          /* Local: number of started queued frames        */
+#endif
+    CPU_INT08U    ftx;                                /* Local: transmit frame buffer available        */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+#if CANBUS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return CAN_ERR_BUSID;
+    }
+    if (CanBusTbl[busId].Cfg == NULL_PTR) {           /* is bus not enabled?                           */
+        can_errnum = CAN_ERR_NULLPTR;
+        return CAN_ERR_NULLPTR;
+    }
+    if (buffer == NULL_PTR) {                         /* does buffer points to valid address ?         */
+        can_errnum = CAN_ERR_NULLPTR;
+        return CAN_ERR_NULLPTR;
+    }
+    if (size != sizeof(CANFRM)) {                     /* is size invalid?                              */
+        can_errnum = CAN_ERR_FRMSIZE;
+        return CAN_ERR_FRMSIZE;
+    }
+#endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
+
+    bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
+    cfg = bus->Cfg;                                   /* set pointer to bus configuration              */
+    ftx = CANOS_PendTxFrame(bus->TxTimeout, busId);   /* check space in transmit buffer                */
+    wr  = bus->BufTxWr;                               /* get write counter (only written by this task) */
+
+#if (CANBUS_TX_HANDLER_EN > 0) && (CANBUS_TX_PRIO_EN == 0)
+    if (ftx != 0u) {                                  /* see if we have space in transmit buffer       */
+        frm = &bus->BufTx[wr & bus->TxMask];          /* get next (not yet published) write location   */
+        CanBusCpy((void *)frm,                        /* copy buffer to can frame memory               */
+                   buffer,
+                   (CPU_INT08U)sizeof(CANFRM));
+#if CANBUS_TX_CONFIRM_EN > 0
+        CANBUS_TX_TAG(frm) = 0u;                      /* frame without confirmation                    */
+#endif
+        CANBUS_MB();                                  /* complete copy before publishing the entry     */
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    ready = CanBusTxReady(bus);                       /* get CAN bus device tx buffer status           */
+                                                      /* see if canbus tx buffer is ready/idle and no  */
+                                                      /* queued frame must be sent before this frame   */
+#if CANBUS_TX_CONFIRM_EN > 0
+    if (CANBUS_TX_SENT_FULL(bus)) {                   /* see, if a frame waits for confirmation        */
+        ready = CAN_FALSE;                            /* yes: queue frame for the TX-ISR               */
+    }
+#endif
+    if ((ready == CAN_TRUE) &&
+        (bus->BufTxRd == wr)) {
+        result = cfg->Write(bus->Dev, buffer,         /* write can frame to can bus interface          */
+                            CANFRM_DRV_SIZE);
+#if CANBUS_TX_CONFIRM_EN > 0
+        if (result == (CPU_INT16S)CANFRM_DRV_SIZE) {  /* see, if frame is accepted by the device       */
+            CanBusTxSent(bus, 0u);                    /* frame without confirmation is in the device   */
+        }
+#endif
+#if CANBUS_STAT_EN > 0
+        if (result == (CPU_INT16S)CANFRM_DRV_SIZE) {  /* see, if frame is accepted by the device       */
+            bus->TxOk++;                              /* increment transmission counter                */
+            bus->TxBits += CanBusFrmBits((CANFRM *)buffer);
+        } else {
+            bus->TxErr++;                             /* no: increment driver error counter            */
+        }
+#endif
+        CPU_CRITICAL_EXIT();                          /* enable all interrupts                         */
+        CANSetErrRegister(result);
+
+        if (ftx != 0u) {                              /* see, if a buffer entry is reserved            */
+            CANOS_PostTxFrame(busId);                 /* release transmit buffer reservation           */
+        }
+    }
+#if CANBUS_TX_HANDLER_EN > 0                          /* use buffer only when tx IRQ is enabled        */
+    else {                                            /* otherwise: tx interrupt is enabled            */
+        if (ftx != 0u) {                              /* see if we have space in transmit buffer       */
+#if CANBUS_TX_PRIO_EN > 0
+            CanBusTxPush(bus, (CANFRM *)buffer, 0u);  /* insert frame in transmit heap                 */
+#else
+            bus->BufTxWr = wr + 1u;                   /* publish frame to TX-ISR                       */
+#endif
+#if CANBUS_STAT_EN > 0
+            CanBusStatHwm(&bus->TxHwm, (CPU_INT16U)(bus->BufTxWr - bus->BufTxRd));
+#endif
+            result = CAN_ERR_NONE;                    /* indicate successful transmission              */
+        } else {                                      /* otherwise: buffer is full                     */
+            result = CAN_ERR_UNKNOWN;                 /* indicate error during transmission            */
+        }
+        CPU_CRITICAL_EXIT();                          /* enable all interrupts                         */
+
+        if (ready == CAN_TRUE) {                      /* see, if device is idle with queued frames     */
+            sent = CanBusTxStart(bus);                /* yes: start transmission of queued frames      */
+        }
+        CANOS_PostTxFrameN(busId, sent);              /* release entries of started frames             */
+    }
+#else
+    else {
+        CPU_CRITICAL_EXIT();                          /* enable all interrupts                         */
+        if (ftx != 0u) {                              /* see, if a buffer entry is reserved            */
+            CANOS_PostTxFrame(busId);                 /* release transmit buffer reservation           */
+        }
+    }
+#endif
+
+#if CANBUS_STAT_EN > 0
+    if (result < CAN_ERR_NONE) {                      /* otherwise: no queue/message buffer free       */
+        bus->TxLost++;                                /* no: increment transmission lost counter       */
+    }
+#endif                                                /* CANBUS_STAT_EN > 0                            */
+
+    CANSetErrRegister(result);
+
+    return(result);                                   /* return function result                        */
+}
+
+
+/*
+*********************************************************************************************************
+*                                          CanBusWriteAsync()
+*
+* Description : This function is called by the application to queue a CAN frame for transmission without
+*               waiting for the transmission. The given function is called, when the frame is sent to the
+*               bus or when the frame is removed from the transmit queue or the device.
+*
+* Argument(s) : busId     Bus identifier
+*
+*               buffer    Pointer to CAN frame in format CANFRM
+*
+*               size      Length of CAN frame memory
+*
+*               func      Confirmation function, which is called with the given argument and the result
+*                         CAN_ERR_NONE (frame sent) or CAN_ERR_TXABORT (frame aborted)
+*
+*               arg       Argument of the confirmation function
+*
+* Return(s)   : Errorcode, if an error is detected, otherwise CAN_ERR_NONE. The errorcode CAN_ERR_BUFFSIZE
+*               indicates, that all confirmation entries are used.
+*
+* Note(s)     : The confirmation function is called within CanBusTxHandler() or with disabled interrupts
+*               within the transmit queue operations, and shall therefore be short.
+*
+*               While transmit confirmation is enabled, only one frame is written to the device at a time.
+*               The frame is confirmed with the next transmit interrupt, so the confirmation works with
+*               devices, which send their transmit mailboxes in identifier priority order.
+*********************************************************************************************************
+*/
+
+#if CANBUS_TX_CONFIRM_EN > 0
+CPU_INT16S  CanBusWriteAsync (CPU_INT16S      busId,
+                              void           *buffer,
+                              CPU_INT16U      size,
+                              CANBUS_TX_FUNC  func,
+                              void           *arg)
+{
+    CANBUS_DATA  *bus;                                /* Local: Pointer to bus data                    */
+    CPU_INT16U    sent = 0u;                          /* Local: number of started queued frames        */
+    CPU_INT16U    i;                                  /* Local: loop variable                          */
+    CPU_INT08U    tag;                                /* Local: confirmation tag of the frame          */
+#if CANBUS_TX_PRIO_EN == 0
+    CPU_INT16U    wr;                                 /* Local: transmit buffer write counter          */
+#endif
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+#if CANBUS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return CAN_ERR_BUSID;
+    }
+    if (CanBusTbl[busId].Cfg == NULL_PTR) {           /* is bus not enabled?                           */
+        can_errnum = CAN_ERR_NULLPTR;
+        return CAN_ERR_NULLPTR;
+    }
+    if ((buffer == NULL_PTR) ||                       /* does buffer points to valid address ?         */
+        (func   == NULL_PTR)) {                       /* is confirmation function invalid?             */
+        can_errnum = CAN_ERR_NULLPTR;
+        return CAN_ERR_NULLPTR;
+    }
+    if (size != sizeof(CANFRM)) {                     /* is size invalid?                              */
+        can_errnum = CAN_ERR_FRMSIZE;
+        return CAN_ERR_FRMSIZE;
+    }
+#endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
+
+    bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
+
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    i = 0u;
+    while ((i < CANBUS_TX_CONFIRM_N) &&               /* search free confirmation entry                */
+           (bus->TxCbFunc[i] != NULL_PTR)) {
+        i++;
+    }
+    if (i < CANBUS_TX_CONFIRM_N) {                    /* see, if a free entry is found                 */
+        bus->TxCbFunc[i] = func;                      /* yes: allocate entry                           */
+        bus->TxCbArg[i]  = arg;
+    }
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
+    if (i >= CANBUS_TX_CONFIRM_N) {                   /* see, if all entries are used                  */
+        can_errnum = CAN_ERR_BUFFSIZE;
+        return CAN_ERR_BUFFSIZE;
+    }
+    tag = (CPU_INT08U)(i + 1u);                       /* tag refers to the confirmation entry          */
+
+    if (CANOS_PendTxFrame(bus->TxTimeout, busId) == 0u) { /* wait for space in transmit buffer         */
+        CPU_CRITICAL_ENTER();                         /* disable all interrupts                        */
+        bus->TxCbFunc[i] = NULL_PTR;                  /* release confirmation entry                    */
+#if CANBUS_STAT_EN > 0
+        bus->TxLost++;                                /* increment transmission lost counter           */
+#endif
+        CPU_CRITICAL_EXIT();                          /* enable all interrupts                         */
+        can_errnum = CAN_ERR_UNKNOWN;
+        return CAN_ERR_UNKNOWN;
+    }
+
+#if CANBUS_TX_PRIO_EN == 0
+    wr = bus->BufTxWr;                                /* get write counter (only written by this task) */
+    CanBusCpy((void *)&bus->BufTx[wr & bus->TxMask],  /* copy buffer to can frame memory               */
+              buffer,
+              (CPU_INT08U)sizeof(CANFRM));
+    CANBUS_TX_TAG(&bus->BufTx[wr & bus->TxMask]) = tag;
+    CANBUS_MB();                                      /* complete copy before publishing the entry     */
+#endif
+
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+#if CANBUS_TX_PRIO_EN > 0
+    CanBusTxPush(bus, (CANFRM *)buffer, tag);         /* insert frame in transmit heap                 */
+#else
+    bus->BufTxWr = wr + 1u;                           /* publish frame to TX-ISR                       */
+#endif
+#if CANBUS_STAT_EN > 0
+    CanBusStatHwm(&bus->TxHwm, (CPU_INT16U)(bus->BufTxWr - bus->BufTxRd));
+#endif
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
+
+    sent = CanBusTxStart(bus);                        /* start transmission, if device is idle         */
+
+    CANOS_PostTxFrameN(busId, sent);                  /* release entries of started frames             */
+
+    return CAN_ERR_NONE;                              /* return function result                        */
+}
+#endif                                                /* CANBUS_TX_CONFIRM_EN > 0                      */
+
+
+/*
+*********************************************************************************************************
+*                                            CanBusWriteN()
+*
+* Description : This function is called by the application to send multiple CAN frames on the opened CAN
+*               bus with a single call. The function waits (within the configured timeout) for at least
+*               one free entry in the transmit buffer and reserves all free entries, which are needed for
+*               the given frames, at once. The accepted frames are queued with a single update of the
+*               transmit buffer, and the free transmit resources of the device are filled directly.
+*
+* Argument(s) : busId     Bus identifier
+*
+*               frames    Pointer to array of CAN frames in format CANFRM
+*
+*               num       Number of CAN frames in the frame array
+*
+* Return(s)   : Errorcode, if an error is detected, otherwise the number of accepted CAN frames. The
+*               frames are accepted in order; frames after the returned number are not sent.
+*
+* Note(s)     : The maximal number of frames, which can be accepted with a single call, is limited to
+*               the transmit queue size of the bus and to 32767.
+*********************************************************************************************************
+*/
+
+CPU_INT16S  CanBusWriteN (CPU_INT16S   busId,
+                          CANFRM      *frames,
+                          CPU_INT16U   num)
+{
+#if CANBUS_TX_HANDLER_EN == 0
+    CANBUS_PARA  *cfg;                                /* Local: Pointer to bus configuration           */
+    CPU_INT16S    err;                                /* Local: errorcode of device driver             */
+#endif
+    CANBUS_DATA  *bus;                                /* Local: Pointer to bus data                    */
+    CPU_INT16U    res;                                /* Local: number of reserved buffer entries      */
+    CPU_INT16U    sent = 0u;                          /* Local: number of written frames               */
+#if CANBUS_STAT_EN > 0
+    CPU_INT16U    req  = num;                         /* Local: number of requested frames             */
+#endif
+#if CANBUS_TX_HANDLER_EN > 0
+#if CANBUS_TX_PRIO_EN == 0
+    CPU_INT16U    wr;                                 /* Local: transmit buffer write counter          */
+#endif
+    CPU_INT16U    i;                                  /* Local: loop variable                          */
+#endif
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+#if CANBUS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return CAN_ERR_BUSID;
+    }
+    if (CanBusTbl[busId].Cfg == NULL_PTR) {           /* is bus not enabled?                           */
+        can_errnum = CAN_ERR_NULLPTR;
+        return CAN_ERR_NULLPTR;
+    }
+    if (frames == NULL_PTR) {                         /* does frames points to valid address ?         */
+        can_errnum = CAN_ERR_NULLPTR;
+        return CAN_ERR_NULLPTR;
+    }
+#endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
+
+    bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
+#if CANBUS_TX_HANDLER_EN == 0
+    cfg = bus->Cfg;                                   /* set pointer to bus configuration              */
+#endif
+    if (num > (CPU_INT16U)(bus->TxMask + 1u)) {       /* limit to the transmit buffer size             */
+        num = (CPU_INT16U)(bus->TxMask + 1u);
+    }
+    if (num > CANBUS_NUM_MAX) {                       /* limit to the range of the function result     */
+        num = CANBUS_NUM_MAX;
+    }
+                                                      /* reserve space in transmit buffer              */
+    res = CANOS_PendTxFrameN(bus->TxTimeout, busId, num);
+
+#if CANBUS_TX_HANDLER_EN > 0                          /* use buffer only when tx IRQ is enabled        */
+#if CANBUS_TX_PRIO_EN > 0
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    for (i = 0u; i < res; i++) {                      /* insert frames in transmit heap                */
+        CanBusTxPush(bus, &frames[i], 0u);
+    }
+#else
+    wr = bus->BufTxWr;                                /* get write counter (only written by this task) */
+    for (i = 0u; i < res; i++) {                      /* copy frames to reserved buffer entries        */
+        bus->BufTx[(CPU_INT16U)(wr + i) & bus->TxMask] = frames[i];
+#if CANBUS_TX_CONFIRM_EN > 0
+        CANBUS_TX_TAG(&bus->BufTx[(CPU_INT16U)(wr + i) & bus->TxMask]) = 0u;
+#endif
+    }
+    CANBUS_MB();                                      /* complete copy before publishing the entries   */
 
-                                                      /*-----------------------------------------------*/
-        case CANBUS_SET_RX_TIMEOUT:                   /*                Set RX timeout                 */
-                                                      /*-----------------------------------------------*/
-            if (argp != NULL_PTR) {                   /* see, if argument pointer is valid             */
-                bus->RxTimeout = *(CPU_INT16U*)argp;  /* set new timeout value                         */
-                result = CAN_ERR_NONE;                /* indicate successful operation                 */
-            }
-            else {
-                result = CAN_ERR_NULLPTR;             /* indicate an error                             */
-            }
-            break;
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    bus->BufTxWr = wr + res;                          /* publish frames to TX-ISR                      */
+#endif
+#if CANBUS_STAT_EN > 0
+    CanBusStatHwm(&bus->TxHwm, (CPU_INT16U)(bus->BufTxWr - bus->BufTxRd));
+#endif
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
 
-                                                      /*-----------------------------------------------*/
-        case CANBUS_SET_TX_TIMEOUT:                   /*                Set TX timeout                 */
-                                                      /*-----------------------------------------------*/
-            if (argp != NULL_PTR) {                   /* see, if argument pointer is valid             */
-                bus->TxTimeout = *(CPU_INT16U*)argp;  /* set new timeout value                         */
-                result = CAN_ERR_NONE;                /* indicate successful operation                 */
-            }
-            else {
-                result = CAN_ERR_NULLPTR;             /* indicate an error                             */
-            }
+    sent = CanBusTxStart(bus);                        /* fill device with queued frames, if it is idle */
+    CANOS_PostTxFrameN(busId, sent);                  /* release entries of written frames             */
+#else
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    while (sent < res) {                              /* write frames while device is ready            */
+        if (CanBusTxReady(bus) == CAN_FALSE) {        /* see, if device is not ready                   */
+            break;
+        }
+        err = cfg->Write(bus->Dev,                    /* write can frame to can bus interface          */
+                         (void *)&frames[sent],
+                         CANFRM_DRV_SIZE);
+        if (err != (CPU_INT16S)CANFRM_DRV_SIZE) {     /* see, if frame is not accepted by the device   */
+            CANSetErrRegister(err);
+#if CANBUS_STAT_EN > 0
+            bus->TxErr++;                             /* increment driver error counter                */
+#endif
             break;
+        }
+#if CANBUS_STAT_EN > 0
+        bus->TxOk++;                                  /* increment transmission counter                */
+        bus->TxBits += CanBusFrmBits(&frames[sent]);  /* add frame to transmitted bus bits             */
+#endif
+        sent++;
+    }
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
 
-                                                      /*-----------------------------------------------*/
-        default:                                      /*        Unsupported function code              */
-            result = CAN_ERR_IOCTRLFUNC;              /* indicate successful operation                 */
-                                                      /*-----------------------------------------------*/
-            break;                                    /* don't indicate successful operation           */
-    }                                                 /*-----------------------------------------------*/
+    CANOS_PostTxFrameN(busId, res);                   /* release transmit buffer reservation           */
+    res = sent;                                       /* only written frames are accepted              */
+#endif
 
-    CANSetErrRegister(result);
+#if CANBUS_STAT_EN > 0
+    CPU_CRITICAL_ENTER();                             /* counter is shared with the other writers      */
+    bus->TxLost += (CPU_INT16U)(req - res);           /* count all not accepted frames as lost         */
+    CPU_CRITICAL_EXIT();
+#endif                                                /* CANBUS_STAT_EN > 0                            */
 
-    return(result);                                   /* return function result                        */
+    return ((CPU_INT16S)res);                         /* return number of accepted frames              */
 }
 
 
 /*
 *********************************************************************************************************
-*                                            CanBusRead()
+*                                          CanBusTxReserve()
 *
-* Description : This function is called by the application to obtain a frame from the opened CAN bus. The
-*               function will wait for a frame to be received on the CAN bus or until the configured
+* Description : This function is called by the application to get direct access to free entries within
+*               the transmit buffer. The application builds the CAN frames directly within these entries
+*               and queues them for transmission with CanBusTxCommit(). If no entry is reserved, the
+*               function will wait for free entries in the transmit buffer or until the configured
 *               timeout is reached.
 *
 * Argument(s) : busId     Bus identifier
 *
-*               buffer    Pointer to CAN frame in format CANFRM
+*               frames    Pointer to the location, which receives the pointer to the first reserved entry
 *
-*               size      Size of CAN frame
+*               max       Maximal number of entries, which shall be reserved
 *
-* Return(s)   : Errorcode CAN_ERR_UNKNOWN, if an error is detected, otherwise size of can frame for
-*               successful reading.
+* Return(s)   : Errorcode, if an error is detected, otherwise the number of reserved entries, which are
+*               located in sequence at the returned frame pointer (0 if no entry is free within timeout).
 *
-* Note(s)     : This function has the standard device driver interface, decribed in the porting chapter
-*               of the user manual. This allows the CAN bus handling via the standard device driver
-*               interface.
+* Note(s)     : The reserved entries end at the end of the transmit buffer. Subsequent calls without a
+*               commit return the same entries. Between reservation and commit, no other transmit
+*               function shall be called for this bus.
 *********************************************************************************************************
 */
 
-CPU_INT16S  CanBusRead (CPU_INT16S   busId,
-                        void        *buffer,
-                        CPU_INT16U   size)
+#if CANBUS_TX_HANDLER_EN > 0
+CPU_INT16S  CanBusTxReserve (CPU_INT16S   busId,
+                             CANFRM     **frames,
+                             CPU_INT16U   max)
+{
+    CANBUS_DATA  *bus;                                /* Local: Pointer to bus data                    */
+    CPU_INT16U    wr;                                 /* Local: transmit buffer write counter          */
+    CPU_INT16U    num;                                /* Local: number of entries up to buffer end     */
+
+
+#if CANBUS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return (CAN_ERR_BUSID);
+    }
+    if (CanBusTbl[busId].Cfg == NULL_PTR) {           /* is bus not enabled?                           */
+        can_errnum = CAN_ERR_NULLPTR;
+        return (CAN_ERR_NULLPTR);
+    }
+    if (frames == NULL_PTR) {                         /* does frames points to valid address ?         */
+        can_errnum = CAN_ERR_NULLPTR;
+        return (CAN_ERR_NULLPTR);
+    }
+#endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
+
+    bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
+#if CANBUS_TX_PRIO_EN > 0
+    if (bus->TxReserved == 0u) {                      /* see, if no entry is reserved                  */
+                                                      /* yes: entries behind the end of the heap       */
+        bus->TxResBase = (CPU_INT16U)(bus->BufTxWr - bus->BufTxRd);
+    }
+    wr  = bus->TxResBase;                             /* get location of first reserved entry          */
+#else
+    wr  = bus->BufTxWr;                               /* get write counter (only written by this task) */
+#endif
+    num = (CPU_INT16U)(bus->TxMask + 1u) - (wr & bus->TxMask); /* entries up to the buffer end       */
+    if (num > max) {                                  /* limit to the requested number of entries      */
+        num = max;
+    }
+    if (bus->TxReserved == 0u) {                      /* see, if no entry is reserved                  */
+                                                      /* yes: reserve space in transmit buffer         */
+        bus->TxReserved = CANOS_PendTxFrameN(bus->TxTimeout, busId, num);
+    }
+    *frames = &bus->BufTx[wr & bus->TxMask];          /* set pointer to first reserved entry           */
+
+    return ((CPU_INT16S)bus->TxReserved);             /* return number of reserved entries             */
+}
+#endif                                                /* CANBUS_TX_HANDLER_EN > 0                      */
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusTxCommit()
+*
+* Description : This function is called by the application to queue frames, which are built within the
+*               entries of CanBusTxReserve(), for transmission. Remaining reserved entries are released.
+*
+* Argument(s) : busId     Bus identifier
+*
+*               num       Number of frames, which shall be transmitted
+*
+* Return(s)   : Errorcode, if an error is detected, otherwise CAN_ERR_NONE for successful operation.
+*
+* Note(s)     : The number of frames must not exceed the number of reserved entries.
+*********************************************************************************************************
+*/
+
+#if CANBUS_TX_HANDLER_EN > 0
+CPU_INT16S  CanBusTxCommit (CPU_INT16S   busId,
+                            CPU_INT16U   num)
 {
-    CANFRM       *frm;                                /* Local: Pointer to received can frame          */
     CANBUS_DATA  *bus;                                /* Local: Pointer to bus data                    */
+    CPU_INT16U    sent = 0u;                          /* Local: number of written frames               */
+#if (CANBUS_TX_PRIO_EN > 0) || (CANBUS_TX_CONFIRM_EN > 0)
+    CPU_INT16U    i;                                  /* Local: loop variable                          */
+#endif
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+#if CANBUS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return (CAN_ERR_BUSID);
+    }
+    if (CanBusTbl[busId].Cfg == NULL_PTR) {           /* is bus not enabled?                           */
+        can_errnum = CAN_ERR_NULLPTR;
+        return (CAN_ERR_NULLPTR);
+    }
+#endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
+
+    bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
+    if (num > bus->TxReserved) {                      /* see, if more frames than reserved             */
+        can_errnum = CAN_ERR_BUFFSIZE;
+        return (CAN_ERR_BUFFSIZE);
+    }
+#if CANBUS_TX_PRIO_EN > 0
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    for (i = 0u; i < num; i++) {                      /* insert frames in transmit heap                */
+        CanBusTxPush(bus, &bus->BufTx[bus->TxResBase + i], 0u);
+    }
+#else
+#if CANBUS_TX_CONFIRM_EN > 0
+    for (i = 0u; i < num; i++) {                      /* reserved frames without confirmation          */
+        CANBUS_TX_TAG(&bus->BufTx[(CPU_INT16U)(bus->BufTxWr + i) & bus->TxMask]) = 0u;
+    }
+#endif
+    CANBUS_MB();                                      /* complete frames before publishing the entries */
+
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    bus->BufTxWr += num;                              /* publish frames to TX-ISR                      */
+#endif
+#if CANBUS_STAT_EN > 0
+    CanBusStatHwm(&bus->TxHwm, (CPU_INT16U)(bus->BufTxWr - bus->BufTxRd));
+#endif
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
+
+    sent = CanBusTxStart(bus);                        /* fill device with queued frames, if it is idle */
+                                                      /* release unused and written entries            */
+    CANOS_PostTxFrameN(busId, (CPU_INT16U)(bus->TxReserved - num) + sent);
+    bus->TxReserved = 0u;
+
+    return (CAN_ERR_NONE);                            /* return function result                        */
+}
+#endif                                                /* CANBUS_TX_HANDLER_EN > 0                      */
+
+
+/*
+*********************************************************************************************************
+*                                          CanBusSubscribe()
+*
+* Description : Registers a receive subscriber on a CAN bus. All received frames of the bus, which match
+*               the given identifier and mask, are stored by the RX-ISR in the given frame buffer of the
+*               subscriber instead of the bus receive queue.
+*
+* Argument(s) : busId        bus identifier
+*
+*               identifier   identifier of the subscribed frames (including RTR and EXT flag)
+*
+*               mask         mask of the identifier bits, which must match
+*
+*               buf          frame buffer of the subscriber
+*
+*               size         number of entries in the frame buffer (must be a power of 2)
+*
+* Return(s)   : The subscriber identifier (0 ... CANBUS_SUB_N-1), or an errorcode, if an error
+*               is detected.
+*
+* Note(s)     : If several subscribers match a frame, the subscriber with the lowest identifier gets
+*               the frame. Each subscriber must be read by a single task.
+*********************************************************************************************************
+*/
+
+#if CANBUS_SUB_EN > 0
+CPU_INT16S  CanBusSubscribe (CPU_INT16S   busId,
+                             CPU_INT32U   identifier,
+                             CPU_INT32U   mask,
+                             CANFRM      *buf,
+                             CPU_INT16U   size)
+{
+    CANBUS_SUB   *sub;                                /* Local: pointer to subscriber                  */
+    CPU_INT16S    subId;                              /* Local: subscriber identifier                  */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+#if CANBUS_ARG_CHK_EN > 0
+    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
+        can_errnum = CAN_ERR_BUSID;
+        return (CAN_ERR_BUSID);
+    }
+    if (buf == NULL_PTR) {                            /* does buf points to valid address ?            */
+        can_errnum = CAN_ERR_NULLPTR;
+        return (CAN_ERR_NULLPTR);
+    }
+#endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
+
+    if ((size == 0u) || ((size & (size - 1u)) != 0u)) { /* is size no power of 2?                      */
+        can_errnum = CAN_ERR_BUFFSIZE;
+        return (CAN_ERR_BUFFSIZE);
+    }
+
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    sub = &CanBusSubTbl[0];
+    for (subId = 0; subId < (CPU_INT16S)CANBUS_SUB_N; subId++) {
+        if (sub->BusId < 0) {                         /* see, if subscriber entry is unused            */
+            sub->BusId = (CPU_INT16S)CANBUS_N;        /* yes: reserve entry                            */
+            break;
+        }
+        sub++;
+    }
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
+    if (subId >= (CPU_INT16S)CANBUS_SUB_N) {          /* see, if no unused entry is found              */
+        can_errnum = CAN_ERR_SUBID;
+        return (CAN_ERR_SUBID);
+    }
+
+    sub->Identifier = identifier & mask;              /* set up subscriber                             */
+    sub->Mask       = mask;
+    sub->Buf        = buf;
+    sub->QMask      = size - 1u;
+    sub->Rd         = 0u;
+    sub->Wr         = 0u;
+#if CANBUS_STAT_EN > 0
+    sub->Lost       = 0u;
+#endif
+    CANOS_ResetSub(subId);
+
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    sub->BusId = busId;                               /* link subscriber to the bus                    */
+    CanBusTbl[busId].SubNum++;
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
+
+    return (subId);                                   /* return subscriber identifier                  */
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CanBusUnsubscribe()
+*
+* Description : Removes a receive subscriber. Further received frames with the subscribed identifiers are
+*               stored in the bus receive queue.
+*
+* Argument(s) : subId    subscriber identifier
+*
+* Return(s)   : Errorcode, if an error is detected, otherwise CAN_ERR_NONE.
+*
+* Note(s)     : -
+*********************************************************************************************************
+*/
+
+CPU_INT16S  CanBusUnsubscribe (CPU_INT16S  subId)
+{
+    CANBUS_SUB   *sub;                                /* Local: pointer to subscriber                  */
+    CPU_INT16S    result = CAN_ERR_SUBID;             /* Local: function result                        */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+#if CANBUS_ARG_CHK_EN > 0
+    if ((subId < 0) || ((CPU_INT16U)subId >= CANBUS_SUB_N)) { /* is subId out of range?                */
+        can_errnum = CAN_ERR_SUBID;
+        return (CAN_ERR_SUBID);
+    }
+#endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
+
+    sub = &CanBusSubTbl[subId];
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    if ((sub->BusId >= 0) &&                          /* see, if subscriber is linked to a bus         */
+        (sub->BusId < (CPU_INT16S)CANBUS_N)) {
+        CanBusTbl[sub->BusId].SubNum--;
+        sub->BusId = -1;                              /* mark subscriber unused                        */
+        result     = CAN_ERR_NONE;
+    }
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
+
+    CANSetErrRegister(result);
+
+    return (result);                                  /* return function result                        */
+}
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusSubRead()
+*
+* Description : Reads the next CAN frame from the queue of a receive subscriber. If the queue is empty,
+*               this function waits for a frame. If a timeout of 0 ticks is given, this function waits
+*               forever, otherwise this function waits for maximal timeout ticks.
+*
+* Argument(s) : subId     subscriber identifier
+*
+*               buffer    Pointer to CAN frame
+*
+*               size      Length of CAN frame memory
+*
+*               timeout   Timeout in OS time ticks
+*
+* Return(s)   : Number of bytes in CAN frame, or an errorcode, if an error is detected.
+*
+* Note(s)     : This function must be called by a single task for each subscriber.
+*********************************************************************************************************
+*/
+
+CPU_INT16S  CanBusSubRead (CPU_INT16S   subId,
+                           void        *buffer,
+                           CPU_INT16U   size,
+                           CPU_INT16U   timeout)
+{
+    CANBUS_SUB   *sub;                                /* Local: pointer to subscriber                  */
     CPU_INT16S    result = CAN_ERR_UNKNOWN;           /* Local: Function result                        */
-    CPU_INT08U    frx;                                /* Local: indication for 'frame received'        */
+    CPU_INT16U    rd;                                 /* Local: subscriber read counter                */
+
+
+#if CANBUS_ARG_CHK_EN > 0
+    if ((subId < 0) || ((CPU_INT16U)subId >= CANBUS_SUB_N)) { /* is subId out of range?                */
+        can_errnum = CAN_ERR_SUBID;
+        return (CAN_ERR_SUBID);
+    }
+    if (buffer == NULL_PTR) {                         /* does buffer points to valid address ?         */
+        can_errnum = CAN_ERR_NULLPTR;
+        return (CAN_ERR_NULLPTR);
+    }
+    if (size != sizeof(CANFRM)) {                     /* is size invalid?                              */
+        can_errnum = CAN_ERR_FRMSIZE;
+        return (CAN_ERR_FRMSIZE);
+    }
+#endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
+
+    sub = &CanBusSubTbl[subId];
+    if (CANOS_PendSubFrame(timeout, subId) != 0u) {   /* wait for a CAN frame from RX-ISR              */
+        rd = sub->Rd;                                 /* get read counter (only written by this task)  */
+                                                      /* copy can frame to buffer                      */
+        CanBusCpy(buffer, (void *)&sub->Buf[rd & sub->QMask], (CPU_INT08U)sizeof(CANFRM));
+        CANBUS_MB();                                  /* complete copy before releasing the entry      */
+        sub->Rd = rd + 1u;                            /* release entry to RX-ISR                       */
+        result  = (CPU_INT16S)sizeof(CANFRM);         /* set received byte counter                     */
+    }
+
+    CANSetErrRegister(result);
+
+    return (result);                                  /* return function result                        */
+}
+#endif                                                /* CANBUS_SUB_EN > 0                             */
+
+
+/*
+*********************************************************************************************************
+*                                          CanBusRouteAdd()
+*
+* Description : Adds a gateway route to a CAN bus. All received frames of the bus, which match the
+*               identifier and mask of the route, are forwarded by the receive handler to the
+*               destination busses of the route instead of being stored in the bus receive queue.
+*
+* Argument(s) : busId        source bus identifier
+*
+*               route        pointer to the routing rule
+*
+* Return(s)   : The route identifier (0 ... CANBUS_GW_N-1), or an errorcode, if an error is detected.
+*
+* Note(s)     : The routing rule is linked to the route and must stay valid until the route is deleted.
+*               If several routes match a frame, the route with the lowest identifier forwards the frame.
+*               The routed frames are checked by the software acceptance filter and the receive hook
+*               before forwarding, but not by the receive subscribers.
+*********************************************************************************************************
+*/
+
+#if CANBUS_GW_EN > 0
+CPU_INT16S  CanBusRouteAdd (CPU_INT16S           busId,
+                            const CANBUS_ROUTE  *route)
+{
+    CANBUS_GW    *gw;                                 /* Local: pointer to gateway route entry         */
+    CPU_INT16S    routeId;                            /* Local: route identifier                       */
     CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
 
 
@@ -366,152 +3650,145 @@ CPU_INT16S  CanBusRead (CPU_INT16S   busId,
         can_errnum = CAN_ERR_BUSID;
         return (CAN_ERR_BUSID);
     }
-    if (buffer == NULL_PTR) {                         /* does buffer points to valid address ?         */
+    if (route == NULL_PTR) {                          /* does route points to valid address ?          */
         can_errnum = CAN_ERR_NULLPTR;
         return (CAN_ERR_NULLPTR);
     }
-    if (size != sizeof(CANFRM)) {                     /* is size invalid?                              */
-        can_errnum = CAN_ERR_FRMSIZE;
-        return (CAN_ERR_FRMSIZE);
-    }
 #endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
 
-    bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
-    frx = CANOS_PendRxFrame (bus->RxTimeout, busId);  /* wait for a CAN frame from RX-ISR              */
-    if (frx != 0u) {                                  /* See if frame received within timeout          */
-        frm = &bus->BufRx[bus->BufRxRd];              /* get next read location from ringbuffer        */
-                                                      /* copy can frame to buffer                      */
-        CanBusCpy(buffer,(void *)frm, (CPU_INT08U)sizeof(CANFRM));
-        CPU_CRITICAL_ENTER();                         /* disable all interrupts                        */
-        bus->BufRxRd++;                               /* increment next read location                  */
-        if (bus->BufRxRd >= CANBUS_RX_QSIZE) {        /* see, if end of buffer reached                 */
-            bus->BufRxRd = 0u;                        /* yes: reset to start of buffer                 */
+#if CANBUS_N < 32
+    if ((route->DstMask >> CANBUS_N) != 0u) {         /* is destination bus out of range?              */
+        can_errnum = CAN_ERR_BUSID;
+        return (CAN_ERR_BUSID);
+    }
+#endif
+    if ((route->DstMask == 0u) ||                     /* is no destination or the source bus given?    */
+        ((route->DstMask & ((CPU_INT32U)1u << busId)) != 0u)) {
+        can_errnum = CAN_ERR_ROUTEID;
+        return (CAN_ERR_ROUTEID);
+    }
+
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    gw = &CanBusGwTbl[0];
+    for (routeId = 0; routeId < (CPU_INT16S)CANBUS_GW_N; routeId++) {
+        if (gw->BusId < 0) {                          /* see, if route entry is unused                 */
+            gw->BusId = (CPU_INT16S)CANBUS_N;         /* yes: reserve entry                            */
+            break;
         }
-        CPU_CRITICAL_EXIT();                          /* disable all interrupts                        */
-        result = (CPU_INT16S)sizeof(CANFRM);          /* set received byte counter                     */
+        gw++;
+    }
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
+    if (routeId >= (CPU_INT16S)CANBUS_GW_N) {         /* see, if no unused entry is found              */
+        can_errnum = CAN_ERR_ROUTEID;
+        return (CAN_ERR_ROUTEID);
     }
 
-#if CANBUS_STAT_EN > 0
-    if (result == (CPU_INT16S)sizeof(CANFRM)) {       /* see, if no error occurs                       */
-        bus->RxOk++;                                  /* increment receive counter                     */
-    }                                                 /* Failure: we can't get a memory partition      */
-#endif                                                /* CANBUS_STAT_EN > 0                            */
+    gw->Route = route;                                /* set up route                                  */
 
-    CANSetErrRegister(result);
+    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
+    gw->BusId = busId;                                /* link route to the source bus                  */
+    CanBusTbl[busId].RouteNum++;
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
 
-    return (result);                                  /* return function result                        */
+    return (routeId);                                 /* return route identifier                       */
 }
 
 
 /*
 *********************************************************************************************************
-*                                            CanBusWrite()
-*
-* Description : This function is called by the application to send a CAN frame on the opened CAN bus. The
-*               function will wait for the buffer to empty out if the buffer is full. The function returns
-*               to the application if the buffer doesn't empty within the configured timeout. A timeout
-*               value of 0 (standard) means, that the calling function will wait forever for the buffer
-*               to empty out.
-*
-* Argument(s) : busId     Bus identifier
+*                                          CanBusRouteDel()
 *
-*               buffer    Pointer to CAN frame in format CANFRM
+* Description : Removes a gateway route. Further received frames with the routed identifiers are stored
+*               in the receive queue of the source bus.
 *
-*               size      Size of CAN frame
+* Argument(s) : routeId  route identifier
 *
-* Return(s)   : Errorcode CAN_ERR_UNKNOWN, if an error is detected, otherwise size of can frame for
-*               successful writing.
+* Return(s)   : Errorcode, if an error is detected, otherwise CAN_ERR_NONE.
 *
-* Note(s)     : This function has the standard device driver interface, decribed in the porting chapter
-*               of the user manual. This allows the CAN bus handling via the standard device driver
-*               interface.
+* Note(s)     : Frames, which are already stored in the gateway transmit queues, are still transmitted.
 *********************************************************************************************************
 */
 
-CPU_INT16S  CanBusWrite (CPU_INT16S   busId,
-                         void        *buffer,
-                         CPU_INT16U   size)
+CPU_INT16S  CanBusRouteDel (CPU_INT16S  routeId)
 {
-    CANFRM       *frm;                                /* Local: current CAN frame                      */
-    CANBUS_PARA  *cfg;                                /* Local: Pointer to bus configuration           */
-    CANBUS_DATA  *bus;                                /* Local: Pointer to bus data                    */
-    CPU_INT16S    result;                             /* Local: Function result                        */
-    CPU_INT08U    txstatus;                           /* Local: Status of device tx buffer             */
-    CPU_INT08U    ftx;                                /* Local: transmit frame buffer available        */
+    CANBUS_GW    *gw;                                 /* Local: pointer to gateway route entry         */
+    CPU_INT16S    result = CAN_ERR_ROUTEID;           /* Local: function result                        */
     CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
 
 
 #if CANBUS_ARG_CHK_EN > 0
-    if ((busId < 0) || ((CPU_INT16U)busId >= CANBUS_N)) { /* is busId out of range?                    */
-        can_errnum = CAN_ERR_BUSID;
-        return CAN_ERR_BUSID;
-    }
-    if (CanBusTbl[busId].Cfg == NULL_PTR) {           /* is bus not enabled?                           */
-        can_errnum = CAN_ERR_NULLPTR;
-        return CAN_ERR_NULLPTR;
-    }
-    if (buffer == NULL_PTR) {                         /* does buffer points to valid address ?         */
-        can_errnum = CAN_ERR_NULLPTR;
-        return CAN_ERR_NULLPTR;
-    }
-    if (size != sizeof(CANFRM)) {                     /* is size invalid?                              */
-        can_errnum = CAN_ERR_FRMSIZE;
-        return CAN_ERR_FRMSIZE;
+    if ((routeId < 0) || ((CPU_INT16U)routeId >= CANBUS_GW_N)) { /* is routeId out of range?           */
+        can_errnum = CAN_ERR_ROUTEID;
+        return (CAN_ERR_ROUTEID);
     }
 #endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
 
-    bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
-    cfg = bus->Cfg;                                   /* set pointer to bus configuration              */
-    ftx = CANOS_PendTxFrame(bus->TxTimeout, busId);   /* check space in transmit buffer                */
-
+    gw = &CanBusGwTbl[routeId];
     CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
-    result = cfg->IoCtl(bus->Dev,                     /* get CAN bus device tx buffer status           */
-                        cfg->Io[CAN_TX_READY],
-                        (void*)&txstatus);
+    if ((gw->BusId >= 0) &&                           /* see, if route is linked to a bus              */
+        (gw->BusId < (CPU_INT16S)CANBUS_N)) {
+        CanBusTbl[gw->BusId].RouteNum--;
+        gw->BusId = -1;                               /* mark route unused                             */
+        result    = CAN_ERR_NONE;
+    }
+    CPU_CRITICAL_EXIT();                              /* enable all interrupts                         */
+
     CANSetErrRegister(result);
-                                                      /* see if canbus tx buffer is ready/idle         */
-    if (txstatus == (CPU_INT08U)CAN_TRUE) {           /*lint !e644 txstatus set by IoCtl               */
-        result = cfg->Write(bus->Dev, buffer,         /* write can frame to can bus interface          */
-                            (CPU_INT16U)sizeof(CANFRM));
-        CPU_CRITICAL_EXIT();                          /* enable all interrupts                         */
-        CANSetErrRegister(result);
 
-        CANOS_PostTxFrame(busId);                     /* release transmit buffer reservation           */
+    return (result);                                  /* return function result                        */
+}
+#endif                                                /* CANBUS_GW_EN > 0                              */
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusWaitAny()
+*
+* Description : Waits for received CAN frames on any of the given busses. If a timeout of 0 ticks is
+*               given, this function waits forever, otherwise this function waits for maximal timeout
+*               ticks.
+*
+* Argument(s) : busMask   bitmask of busses (bit n = bus n)
+*
+*               timeout   Timeout in OS time ticks
+*
+* Return(s)   : Bitmask of the given busses with received frames (0 = no frame received until timeout).
+*
+* Note(s)     : The frames are not taken out of the receive buffers; they are read with the functions
+*               CanBusRead(), CanBusReadN() or CanBusRxPeek() of the returned busses afterwards.
+*********************************************************************************************************
+*/
+
+#if CANBUS_WAIT_EN > 0
+CPU_INT32U  CanBusWaitAny (CPU_INT32U  busMask,
+                           CPU_INT16U  timeout)
+{
+    CANBUS_DATA  *bus = &CanBusTbl[0];                /* Local: pointer to bus data                    */
+    CPU_INT32U    ready = 0u;                         /* Local: busses with received frames            */
+    CPU_INT16U    i;                                  /* Local: loop variable                          */
+
+
+    busMask &= CANBUS_ALL_MASK;                       /* ignore not existing busses                    */
+    if (busMask == 0u) {
+        can_errnum = CAN_ERR_BUSID;
+        return (0u);
     }
-#if CANBUS_TX_HANDLER_EN > 0                          /* use buffer only when tx IRQ is enabled        */
-    else {                                            /* otherwise: tx interrupt is enabled            */
-        if (ftx != 0u) {                              /* see if we have space in transmit buffer       */
-            frm = &bus->BufTx[bus->BufTxWr];          /* get next write location                       */
-            bus->BufTxWr++;                           /* set write location to next buffer entry       */
-            if (bus->BufTxWr >= CANBUS_TX_QSIZE) {    /* see, if buffer end is reached                 */
-                bus->BufTxWr = 0u;                    /* yes: wrap around to start of buffer           */
-            }
-            CanBusCpy((void *)frm,                    /* copy buffer to can frame memory               */
-                       buffer,
-                       (CPU_INT08U)sizeof(CANFRM));
-            result = CAN_ERR_NONE;                    /* indicate successful transmission              */
-        } else {                                      /* otherwise: buffer is full                     */
-            result = CAN_ERR_UNKNOWN;                 /* indicate error during transmission            */
+
+    CANOS_ClrRxFlags(busMask);                        /* discard outdated indications                  */
+    for (i = 0u; i < CANBUS_N; i++) {                 /* see, if frames are already waiting            */
+        if (((busMask & (1uL << i)) != 0u) &&
+            ((CPU_INT16U)(bus->BufRxWr - bus->BufRxRd) > bus->RxPeek)) {
+            ready |= (1uL << i);
         }
-        CPU_CRITICAL_EXIT();                          /* enable all interrupts                         */
+        bus++;
     }
-#else
-    else {
-        CPU_CRITICAL_EXIT();                          /* enable all interrupts                         */
-        CANOS_PostTxFrame(busId);                     /* release transmit buffer reservation           */
-    }
-#endif
-
-#if CANBUS_STAT_EN > 0
-    if (result < CAN_ERR_NONE) {                      /* otherwise: no queue/message buffer free       */
-        bus->TxLost++;                                /* no: increment transmission lost counter       */
+    if (ready == 0u) {                                /* no: wait for the next received frame          */
+        ready = CANOS_PendRxFlags(timeout, busMask);
     }
-#endif                                                /* CANBUS_STAT_EN > 0                            */
-
-    CANSetErrRegister(result);
 
-    return(result);                                   /* return function result                        */
+    return (ready);                                   /* return busses with received frames            */
 }
+#endif                                                /* CANBUS_WAIT_EN > 0                            */
 
 
 /*
@@ -545,7 +3822,7 @@ CPU_INT16S  CanBusEnable (CANBUS_PARA  *cfg)
         can_errnum = CAN_ERR_NULLPTR;
         return CAN_ERR_NULLPTR;
     }
-    if (cfg->BusNodeName > CANBUS_N) {                /* if BusNodeName is out of range                */
+    if (cfg->BusNodeName >= CANBUS_N) {               /* if BusNodeName is out of range                */
         can_errnum = CAN_ERR_BUSID;
         return CAN_ERR_BUSID;
     }
@@ -578,6 +3855,19 @@ CPU_INT16S  CanBusEnable (CANBUS_PARA  *cfg)
 
     bus = &(CanBusTbl[cfg->BusNodeName]);             /* get element from bus table                    */
     if (bus->Cfg == NULL_PTR) {                       /* this should be disabled                       */
+        result = CanBusQueueInit(bus, cfg);           /* set up receive and transmit queues            */
+        if (result != CAN_ERR_NONE) {
+            can_errnum = result;
+            return result;
+        }
+#if CANBUS_FILTER_EN > 0
+        bus->FilterOn = CAN_FALSE;                    /* accept all frames                             */
+        CanBusFilterClear(bus);
+#endif
+#if CANBUS_STAT_EN > 0
+        bus->LoadTime = CANOS_GetTime();              /* start bus load measurement                    */
+        bus->LoadBits = bus->RxBits + bus->TxBits;
+#endif
         bus->Cfg      = cfg;                          /* link configuration to this element            */
         result = cfg->Init(cfg->DriverDevName);       /* Initialize the CAN bus                        */
         if (result != CAN_ERR_NONE) {
@@ -645,6 +3935,9 @@ CPU_INT16S  CanBusDisable (CPU_INT16S  busId)
     CANBUS_DATA  *bus;                                /* Local: pointer to bus data                    */
     CANBUS_PARA  *cfg;                                /* Local: pointer to bus configuration           */
     CPU_INT16S    err;                                /* Local: errorcode of device driver             */
+#if CANBUS_TX_CONFIRM_EN > 0
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+#endif
 
 
 #if CANBUS_ARG_CHK_EN > 0
@@ -666,6 +3959,12 @@ CPU_INT16S  CanBusDisable (CPU_INT16S  busId)
 
     if (err == CAN_ERR_NONE) {
         err = cfg->Close(bus->Dev);                   /* Close the CAN bus                             */
+#if CANBUS_TX_CONFIRM_EN > 0
+        CPU_CRITICAL_ENTER();                         /* disable all interrupts                        */
+        CanBusTxAbort(busId, bus, CAN_TRUE);          /* abort frames in the device                    */
+        CanBusTxAbort(busId, bus, CAN_FALSE);         /* abort frames in the transmit queue            */
+        CPU_CRITICAL_EXIT();                          /* enable all interrupts                         */
+#endif
         bus->Cfg = NULL_PTR;                          /* remove link to bus configuration              */
         CANSetErrRegister(err);
     }
@@ -691,11 +3990,8 @@ CPU_INT16S  CanBusDisable (CPU_INT16S  busId)
 #if CANBUS_TX_HANDLER_EN > 0
 void  CanBusTxHandler (CPU_INT16S  busId)
 {
-    CANFRM       *frm;                                /* Local: current CAN frame                      */
-    CANBUS_PARA  *cfg;                                /* Local: pointer to bus configuration           */
     CANBUS_DATA  *bus;                                /* Local: pointer to bus data                    */
-    CPU_INT16S    err;
-    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+    CPU_INT16U    num;                                /* Local: number of removed frames               */
 
 
 #if CANBUS_ARG_CHK_EN > 0
@@ -710,28 +4006,22 @@ void  CanBusTxHandler (CPU_INT16S  busId)
 #endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
 
     bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
-    cfg = bus->Cfg;                                   /* set pointer to bus configuration              */
 
-#if CANBUS_STAT_EN > 0
-    bus->TxOk++;                                      /* increment transmission counter                */
-#endif                                                /* CANBUS_STAT_EN > 0                            */
+#if CANBUS_TX_CONFIRM_EN > 0
+    CanBusTxConfirm(busId, bus);                      /* confirm the transmitted frame                 */
+    if (CANBUS_TX_SENT_FULL(bus)) {                   /* see, if a frame waits for confirmation        */
+        return;
+    }
+#endif
+#if CANBUS_GW_EN > 0
+    if (CanBusGwStart(bus) == CAN_TRUE) {             /* forwarded frames are sent first               */
+        return;
+    }
+#endif
 
-    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
-    if (bus->BufTxRd != bus->BufTxWr) {               /* see, if buffer contains pending frames        */
-        frm = &bus->BufTx[bus->BufTxRd];              /* get next frame out of transmit buffer         */
-        bus->BufTxRd++;                               /* set next read location to next entry          */
-        if (bus->BufTxRd >= CANBUS_TX_QSIZE) {        /* see, if buffer end is reached                 */
-            bus->BufTxRd = 0u;                        /* wrap around to start of ringbuffer            */
-        }
-        err = cfg->Write(bus->Dev, (void *)frm,       /* write can frame to can bus interface          */
-                   (CPU_INT16U)sizeof(CANFRM));
-        CPU_CRITICAL_EXIT();                          /* allow all interrupts                          */
-        CANSetErrRegister(err);
+    num = CanBusTxStart(bus);                         /* fill device with queued frames                */
 
-        CANOS_PostTxFrame(busId);                     /* release transmit buffer reservation           */
-    } else {
-        CPU_CRITICAL_EXIT();                          /* allow all interrupts                          */
-    }
+    CANOS_PostTxFrameN(busId, num);                   /* release entries of removed frames             */
 }
 #endif                                                /* CANBUS_TX_HANDLER_EN > 0                      */
 
@@ -747,20 +4037,33 @@ void  CanBusTxHandler (CPU_INT16S  busId)
 * Return(s)   : None.
 *
 * Note(s)     : The calling interrupt vector has to pass the bus identifier as a parameter to the handler.
+*
+*               With CANFRM_TIMESTAMP_EN the time of reception is stored in the CAN frame before the
+*               driver is called, so a driver with a hardware timestamp can replace the value.
+*
+*               If the driver provides a burst read function (CANBUS_PARA.ReadN), all pending frames
+*               are read with a single interrupt and the receive semaphore is posted once per batch.
+*
+*               With CANBUS_RX_DEFER_EN the handler only moves the raw frames into the staging ring of
+*               the bus; all further processing is done by CanBusRxService().
+*
+*               With CANBUS_RX_POLL_EN the handler disables the receive interrupt of the bus, when the
+*               receive load exceeds the enter threshold. The bus is then read by CanBusRxPoll().
 *********************************************************************************************************
 */
 
 #if CANBUS_RX_HANDLER_EN > 0
 void  CanBusRxHandler (CPU_INT16S  busId)
 {
+    CANBUS_DATA  *bus;                                /* Local: pointer to bus data                    */
+#if CANBUS_RX_DEFER_EN == 0
     CANFRM       *frm;                                /* Local: current CAN frame                      */
     CANFRM        dummyfrm;                           /* Local: current CAN frame                      */
     CANBUS_PARA  *cfg;                                /* Local: pointer to bus configuration           */
-    CANBUS_DATA  *bus;                                /* Local: pointer to bus data                    */
-    CPU_INT16S    err;                                /* Local: os errorcode                           */
+    CPU_INT16S    err      = 0;                       /* Local: os errorcode                           */
     CPU_INT16S    consumed = 0;                       /* Local: return value of hook                   */
-    CPU_INT16U    rxnext;                             /* Local: next potential receive location        */
-    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+    CPU_INT16U    wr;                                 /* Local: receive buffer write counter           */
+#endif
 
 
 #if CANBUS_ARG_CHK_EN > 0
@@ -775,52 +4078,255 @@ void  CanBusRxHandler (CPU_INT16S  busId)
 #endif                                                /* CANBUS_ARG_CHK_EN > 0                         */
 
     bus = &CanBusTbl[busId];                          /* set pointer to bus data                       */
+#if CANBUS_RX_POLL_EN > 0
+    if (bus->RxPolling == CAN_FALSE) {                /* see, if called by the receive interrupt       */
+        CanBusRxMode(bus);                            /* yes: check receive load for polling           */
+    }
+#endif
+#if CANBUS_RX_DEFER_EN > 0
+    CanBusRxStage(busId, bus);                        /* only move frames to the staging ring          */
+#else
     cfg = bus->Cfg;                                   /* set pointer to bus configuration              */
 
-    CPU_CRITICAL_ENTER();                             /* disable all interrupts                        */
-    frm = &bus->BufRx[bus->BufRxWr];                  /* get next receive buffer frame entry           */
-    rxnext = bus->BufRxWr + 1u;                       /* calc write location to next receiption        */
-    if (rxnext >= CANBUS_RX_QSIZE) {                  /* see, if en of buffer is reached               */
-        rxnext = 0u;                                  /* wrap around to start of buffer                */
-    }
-    if (rxnext != bus->BufRxRd) {                     /* see, if no buffer overrun occurs              */
+    if (cfg->ReadN != NULL_PTR) {                     /* see, if driver supports burst read            */
+        if (CanBusRxBurst(busId, bus) == CAN_FALSE) { /* read all pending frames                       */
+            return;                                   /* device has no further pending frames          */
+        }
+    }                                                 /* otherwise: read single frame (or overrun)     */
 
-        err = cfg->Read(bus->Dev, (void *)frm,        /* read can frame from can bus interface         */
-                       (CPU_INT16U)sizeof(CANFRM));
+    wr = bus->BufRxWr;                                /* get write counter (only written by this ISR)  */
+                                                      /* see, if no buffer overrun occurs              */
+    if ((CPU_INT16U)(wr - bus->BufRxRd) <= bus->RxMask) {
+        frm = &bus->BufRx[wr & bus->RxMask];          /* get next (not yet published) buffer entry     */
+#if CANFRM_TIMESTAMP_EN > 0
+        frm->Timestamp = CANOS_GetTimestamp();        /* capture reception time (driver may replace)   */
+#endif
+        err = CanBusRxRead(bus, frm);                 /* read can frame from can bus interface         */
         CANSetErrRegister(err);
-        CPU_CRITICAL_EXIT();                          /* allow all interrupts                          */
-
-#if CANBUS_HOOK_RX_EN == 1
-        consumed = CanBusRxHook(busId, (void *)frm);
-#endif                                                /* CANBUS_HOOK_RX_EN == 1                        */
+        if (err == (CPU_INT16S)CANFRM_DRV_SIZE) {     /* see, if a valid CAN frame is received         */
+#if CANBUS_RX_POLL_EN > 0
+            bus->RxPollCnt++;                         /* count frame for the receive load              */
+#endif
+            consumed = CanBusRxProcess(busId, bus, frm);
+        }
+#if CANBUS_STAT_EN > 0
+        else {
+            bus->RxErr++;                             /* no: increment driver error counter            */
+        }
+#endif
 
-        if (consumed == 0) {                          /* see, if CAN frame is not consumed             */
-            CPU_CRITICAL_ENTER();                     /* disable all interrupts                        */
-            bus->BufRxWr = rxnext;                    /* set next location in buffer                   */
-            CPU_CRITICAL_EXIT();                      /* allow all interrupts                          */
+                                                      /* see, if CAN frame is valid and not consumed   */
+        if ((err == (CPU_INT16S)CANFRM_DRV_SIZE) && (consumed == 0)) {
+            CANBUS_MB();                              /* complete entry before publishing it           */
+            bus->BufRxWr = wr + 1u;                   /* publish frame to application                  */
+#if CANBUS_STAT_EN > 0
+            CanBusStatHwm(&bus->RxHwm, (CPU_INT16U)(wr + 1u - bus->BufRxRd));
+#endif
 
-            CANOS_PostRxFrame(busId);                 /* signal a new CAN frame in receive buffer      */
+            CanBusRxPost(busId, bus, 1u);             /* signal a new CAN frame in receive buffer      */
         }
     } else {                                          /* otherwise: no buffer available                */
-        CPU_CRITICAL_EXIT();                          /* allow all interrupts                          */
+#if CANBUS_RX_POLICY_EN > 0
+        if (bus->RxPolicy != CANBUS_RX_DROP_NEWEST) { /* see, if queued frames may be lost             */
+#if CANFRM_TIMESTAMP_EN > 0
+            dummyfrm.Timestamp = CANOS_GetTimestamp();/* capture reception time (driver may replace)   */
+#endif
+            err = CanBusRxRead(bus, &dummyfrm);       /* read can frame from can bus interface         */
+            CANSetErrRegister(err);
+            if (err == (CPU_INT16S)CANFRM_DRV_SIZE) { /* see, if a valid CAN frame is received         */
+                if (CanBusRxProcess(busId, bus, &dummyfrm) == 0) {
+                    CanBusRxShed(busId, bus, &dummyfrm); /* apply overflow policy of the bus           */
+                }
+            }
+#if CANBUS_STAT_EN > 0
+            else {
+                bus->RxErr++;                         /* no: increment driver error counter            */
+                bus->RxLost++;
+            }
+#endif
+            return;
+        }
+#endif                                                /* CANBUS_RX_POLICY_EN > 0                       */
 #if CANBUS_RX_READ_ALWAYS_EN > 0
-        err = cfg->Read(bus->Dev, (void *)&dummyfrm,  /* read can frame from can bus interface         */
-                       (CPU_INT16U)sizeof(CANFRM));
+#if CANFRM_TIMESTAMP_EN > 0
+        dummyfrm.Timestamp = CANOS_GetTimestamp();    /* capture reception time (driver may replace)   */
+#endif
+        err = CanBusRxRead(bus, &dummyfrm);           /* read can frame from can bus interface         */
         CANSetErrRegister(err);
+#if CANBUS_STAT_EN > 0
+        if (err == (CPU_INT16S)CANFRM_DRV_SIZE) {     /* see, if a valid CAN frame is received         */
+            bus->RxBits += CanBusFrmBits(&dummyfrm);  /* add frame to received bus bits                */
+        } else {
+            bus->RxErr++;                             /* no: increment driver error counter            */
+        }
+#endif
+#if (CANBUS_SUB_EN > 0) || (CANBUS_RX_MSG_EN > 0)
+#if CANBUS_SUB_EN > 0
+        if ((err == (CPU_INT16S)CANFRM_DRV_SIZE) &&   /* see, if frame is for a receive subscriber     */
+            (bus->SubNum != 0u)) {
+            consumed = CanBusSubRoute(busId, &dummyfrm);
+        }
+#endif
+#if CANBUS_RX_MSG_EN > 0
+        if ((err == (CPU_INT16S)CANFRM_DRV_SIZE) &&   /* see, if frame is for a CAN message            */
+            (consumed == 0) && (bus->RxMsg == CAN_TRUE)) {
+            if (CanMsgDispatch(&dummyfrm) >= 0) {
+                consumed = 1;
+            }
+        }
+#endif
+        if (consumed == 0) {                          /* see, if frame is not delivered                */
+            err = 0;                                  /* yes: the frame is lost                        */
+        }
+#else
         err = 0;                                      /* set err to 0 to indicated that the            */
                                                       /* frame is lost                                 */
+#endif
+#else
+        if (cfg->ReadN != NULL_PTR) {                 /* see, if driver releases the device mailbox    */
+            (void)CanBusRxRead(bus, &dummyfrm);       /* yes: read and discard the lost frame          */
+        }
 #endif                                                /* CANBUS_RX_READ_ALWAYS_EN > 0                  */
     }
 
 #if CANBUS_STAT_EN > 0
-    if (err != (CPU_INT16S)sizeof(CANFRM)) {          /* see, if an error occurs                       */
+    if (err != (CPU_INT16S)CANFRM_DRV_SIZE) {         /* see, if an error occurs                       */
         bus->RxLost++;                                /* Increment receive CAN frame lost counter      */
+#if CANBUS_RX_POLICY_EN > 0
+        if (err == 0) {                               /* see, if frame is lost due to full buffer      */
+            bus->RxDropNewest++;
+        }
+#endif
     }
 #endif                                                /* CANBUS_STAT_EN > 0                            */
+#endif                                                /* CANBUS_RX_DEFER_EN > 0                        */
 }
 #endif                                                /* CANBUS_RX_HANDLER_EN > 0                      */
 
 
+/*
+*********************************************************************************************************
+*                                          CanBusRxService()
+*
+* Description : Receive service function for the deferred receive processing. The function waits for
+*               frames, which are staged by CanBusRxHandler(), and processes the staged frames of all
+*               busses with the acceptance filter, the receive hook, the receive subscribers and the
+*               statistics. The accepted frames are stored in the receive buffer of the bus.
+*
+* Argument(s) : timeout   Timeout in OS ticks (0 = wait forever)
+*
+* Return(s)   : Number of processed frames (0, if no frame is staged until timeout), limited to 32767.
+*
+* Note(s)     : This function shall be called in an endless loop by a high priority task. The receive
+*               hook is called within this task and not within the receive interrupt.
+*********************************************************************************************************
+*/
+
+#if CANBUS_RX_DEFER_EN > 0
+CPU_INT16S  CanBusRxService (CPU_INT16U  timeout)
+{
+    CPU_INT16U  busId;                                /* Local: loop variable                          */
+    CPU_INT32U  num = 0u;                             /* Local: number of processed frames             */
+
+
+    if (CANOS_PendRxService(timeout) == 0u) {         /* wait for staged frames                        */
+        return (0);
+    }
+    for (busId = 0u; busId < CANBUS_N; busId++) {     /* loop through all busses                       */
+        if (CanBusTbl[busId].Cfg != NULL_PTR) {       /* see, if bus is enabled                        */
+            num += CanBusRxDrain((CPU_INT16S)busId, &CanBusTbl[busId]);
+        }
+    }
+    if (num > CANBUS_NUM_MAX) {                       /* limit to the range of the result              */
+        num = CANBUS_NUM_MAX;
+    }
+    return ((CPU_INT16S)num);                         /* return number of processed frames             */
+}
+#endif                                                /* CANBUS_RX_DEFER_EN > 0                        */
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusRxTimer()
+*
+* Description : Signals the coalesced frames of all busses to the readers, when the coalescing time
+*               since the first not signalled frame is elapsed.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function shall be called periodically (e.g. within the OS tick hook or a timer
+*               callback). The period limits the delay of a frame, when no further frames are received.
+*********************************************************************************************************
+*/
+
+#if CANBUS_RX_COALESCE_EN > 0
+void  CanBusRxTimer (void)
+{
+    CANBUS_DATA  *bus;                                /* Local: pointer to bus data                    */
+    CPU_INT16U    busId;                              /* Local: loop variable                          */
+    CPU_INT32U    now;                                /* Local: current time                           */
+
+
+    now = CANOS_GetTime();
+    bus = &CanBusTbl[0];
+    for (busId = 0u; busId < CANBUS_N; busId++) {     /* loop through all busses                       */
+        if ((bus->RxUnposted != 0u) &&                /* see, if coalescing time is elapsed            */
+            ((CPU_INT32U)(now - bus->RxFirst) >= bus->RxCoalTime)) {
+            CanBusRxFlush((CPU_INT16S)busId, bus);    /* signal all coalesced frames                   */
+        }
+        bus++;
+    }
+}
+#endif                                                /* CANBUS_RX_COALESCE_EN > 0                     */
+
+
+/*
+*********************************************************************************************************
+*                                           CanBusRxPoll()
+*
+* Description : Reads all pending frames of the busses, which are switched to polling because of a high
+*               receive load. A bus with a receive load below the leave threshold is switched back to
+*               the receive interrupt.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Number of read frames of all polled busses, limited to 32767.
+*
+* Note(s)     : This function does not block and shall be called periodically by a high priority task
+*               (e.g. every OS tick). The period limits the receive latency while a bus is polled.
+*********************************************************************************************************
+*/
+
+#if CANBUS_RX_POLL_EN > 0
+CPU_INT16S  CanBusRxPoll (void)
+{
+    CANBUS_DATA  *bus;                                /* Local: pointer to bus data                    */
+    CPU_INT16U    busId;                              /* Local: loop variable                          */
+    CPU_INT16U    cnt;                                /* Local: frame counter before reading           */
+    CPU_INT32U    num = 0u;                           /* Local: number of read frames                  */
+
+
+    bus = &CanBusTbl[0];
+    for (busId = 0u; busId < CANBUS_N; busId++) {     /* loop through all busses                       */
+        if ((bus->Cfg != NULL_PTR) &&                 /* see, if enabled bus is polled                 */
+            (bus->RxPolling == CAN_TRUE)) {
+            cnt = bus->RxPollCnt;
+            CanBusRxHandler((CPU_INT16S)busId);       /* read all pending frames of the device         */
+            num += (CPU_INT16U)(bus->RxPollCnt - cnt);
+            CanBusRxMode(bus);                        /* check receive load for leaving polling        */
+        }
+        bus++;
+    }
+    if (num > CANBUS_NUM_MAX) {                       /* limit to the range of the result              */
+        num = CANBUS_NUM_MAX;
+    }
+    return ((CPU_INT16S)num);                         /* return number of read frames                  */
+}
+#endif                                                /* CANBUS_RX_POLL_EN > 0                         */
+
+
 /*
 *********************************************************************************************************
 *                                          CanBusNSHandler()
@@ -108,6 +108,70 @@ extern "C" {
 
 #define CANBUS_ERROR         -3
 
+
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      RECEIVE OVERFLOW POLICIES
+* \ingroup  UCCAN
+*
+*           These defines hold the codings for the handling of a received frame, which finds the
+*           receive queue full (see CanBusIoCtl() with function code CANBUS_SET_RX_POLICY):
+*           - DROP NEWEST: the received frame is lost (default)
+*           - DROP OLDEST: the oldest queued frame is lost
+*           - EVICT PRIO:  the queued frame with the lowest identifier priority is lost. If the
+*                          received frame has the lowest priority, the received frame is lost.
+*
+* \note     Frames, which are handed out with CanBusRxPeek(), are never removed.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+#define CANBUS_RX_DROP_NEWEST  0u
+#define CANBUS_RX_DROP_OLDEST  1u
+#define CANBUS_RX_EVICT_PRIO   2u
+
+
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      GATEWAY ROUTE: ANY DLC
+* \ingroup  UCCAN
+*
+*           This define holds the coding for a gateway route, which forwards frames with any data
+*           length code (see CANBUS_ROUTE).
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+#define CANBUS_GW_DLC_ANY      0xFFu
+
+
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      MEMORY BARRIER
+* \ingroup  UCCAN
+*
+*           This macro orders the accesses to a frame buffer entry against the update of the
+*           corresponding read or write counter. The frame buffers between the interrupt handlers
+*           and the application tasks are lock-free: a frame is published by incrementing the
+*           write counter after the frame is completely written, and released by incrementing
+*           the read counter after the frame is completely read.
+*
+* \note     The default maps to the uC/CPU barrier CPU_MB(), if available. Otherwise a compiler
+*           barrier is used for the known toolchains. For other targets, this macro must be
+*           defined in can_cfg.h (at least a compiler barrier is required).
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+#ifndef CANBUS_MB
+#if   defined(CPU_MB)
+#define CANBUS_MB()          CPU_MB()
+#elif defined(__GNUC__)
+#define CANBUS_MB()          __asm__ volatile ("" ::: "memory")
+#elif defined(__CC_ARM)
+#define CANBUS_MB()          __schedule_barrier()
+#else
+#error "CANBUS_MB is not defined; define a memory barrier (or at least a compiler barrier) in can_cfg.h!"
+#endif
+#endif
+
 /*-----------------------------------------------------------------------------------------------------*/
 /*!
 * \brief                      I/O CONTROL FUNCTIONCODES
@@ -164,7 +228,116 @@ enum CANBUS_IOCTL_FUNC {
     *       received CAN frame.
     */
     /*-------------------------------------------------------------------------------------------------*/
-    CANBUS_SET_RX_TIMEOUT
+    CANBUS_SET_RX_TIMEOUT,
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  SET ACCEPTANCE FILTER
+    * \ingroup  UCCAN
+    *
+    *       This enum value is the functioncode to enable (CAN_TRUE) or disable (CAN_FALSE) the
+    *       software acceptance filter of the bus. While disabled, all frames are accepted.
+    *
+    * \note Argument pointer type: CPU_BOOLEAN *
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANBUS_SET_FILTER,
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  ADD IDENTIFIER TO ACCEPTANCE FILTER
+    * \ingroup  UCCAN
+    *
+    *       This enum value is the functioncode to accept frames with the given identifier. An
+    *       extended identifier is marked with CANFRM_EXT_FLAG; the RTR flag is ignored.
+    *
+    * \note Argument pointer type: CPU_INT32U *
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANBUS_FILTER_ADD,
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  REMOVE IDENTIFIER FROM ACCEPTANCE FILTER
+    * \ingroup  UCCAN
+    *
+    *       This enum value is the functioncode to reject frames with the given identifier.
+    *
+    * \note Argument pointer type: CPU_INT32U *
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANBUS_FILTER_REMOVE,
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  CLEAR ACCEPTANCE FILTER
+    * \ingroup  UCCAN
+    *
+    *       This enum value is the functioncode to remove all identifiers from the acceptance
+    *       filter. The argument pointer is not used.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANBUS_FILTER_CLEAR,
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  GET BUS STATISTICS
+    * \ingroup  UCCAN
+    *
+    *       This enum value is the functioncode to get a consistent snapshot of the bus statistics.
+    *       The bus load is calculated for the time since the previous snapshot.
+    *
+    * \note Argument pointer type: CANBUS_STAT *
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANBUS_GET_STAT,
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  SET RECEIVE OVERFLOW POLICY
+    * \ingroup  UCCAN
+    *
+    *       This enum value is the functioncode to set the handling of received frames, which
+    *       find the receive queue full (CANBUS_RX_DROP_NEWEST, CANBUS_RX_DROP_OLDEST or
+    *       CANBUS_RX_EVICT_PRIO).
+    *
+    * \note Argument pointer type: CPU_INT08U *
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANBUS_SET_RX_POLICY,
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  SET RECEIVE POST COALESCING
+    * \ingroup  UCCAN
+    *
+    *       This enum value is the functioncode to set the coalescing of the receive signals. The
+    *       reader is woken up after the given number of frames, or after the given time since the
+    *       first not signalled frame. A number of frames of 0 or 1 disables the coalescing.
+    *
+    * \note Argument pointer type: CANBUS_COALESCE *
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANBUS_SET_RX_COALESCE,
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  SET RECEIVE POLLING THRESHOLDS
+    * \ingroup  UCCAN
+    *
+    *       This enum value is the functioncode to set the load thresholds for switching the
+    *       reception of the bus between the receive interrupt and the polling with CanBusRxPoll().
+    *       An enter threshold of 0 disables the polling.
+    *
+    * \note Argument pointer type: CANBUS_POLL *
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANBUS_SET_RX_POLL,
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  SET RECEIVE MESSAGE UNPACKING
+    * \ingroup  UCCAN
+    *
+    *       This enum value is the functioncode to enable (CAN_TRUE) or disable (CAN_FALSE) the
+    *       unpacking of received frames into the CAN messages and signals. Frames without a
+    *       CAN message are stored in the receive queue.
+    *
+    * \note Argument pointer type: CPU_BOOLEAN *
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANBUS_SET_RX_MSG
 };
 
 
@@ -296,10 +469,119 @@ typedef struct {
     */
     /*-------------------------------------------------------------------------------------------------*/
     CPU_INT16U Io[CAN_IO_FUNC_N];
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE QUEUE STORAGE
+    * \ingroup  UCCAN
+    *
+    *       This member holds the pointer to the receive frame buffer of this bus with RxQSize
+    *       entries. If NULL_PTR, the default storage with CANBUS_RX_QSIZE entries is used.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANFRM *RxBuf;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE QUEUE SIZE
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of entries in RxBuf. The size must be a power of 2.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U RxQSize;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMIT QUEUE STORAGE
+    * \ingroup  UCCAN
+    *
+    *       This member holds the pointer to the transmit frame buffer of this bus with TxQSize
+    *       entries. If NULL_PTR, the default storage with CANBUS_TX_QSIZE entries is used.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANFRM *TxBuf;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMIT QUEUE SIZE
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of entries in TxBuf. The size must be a power of 2.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U TxQSize;
+#if CANBUS_TX_PRIO_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMIT SEQUENCE STORAGE
+    * \ingroup  UCCAN
+    *
+    *       This member holds the pointer to an array with TxQSize sequence numbers for the
+    *       transmit heap. It is needed, if TxBuf is not NULL_PTR.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U *TxSeqBuf;
+#endif
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  DRIVER BURST READ FUNCTION
+    * \ingroup  UCCAN
+    *
+    *       This member holds the optional function pointer to a CAN lowlevel device driver
+    *       function, which reads all pending frames (up to num) into consecutive buffer entries
+    *       of size bytes and returns the number of read frames (0 if no frame is pending). If
+    *       NULL_PTR, the receive handler reads a single frame with Read() per interrupt.
+    *
+    * \note The burst read function releases the device receive mailbox of each read frame. If
+    *       it is given, every frame of the device is read with it (single frames and frames,
+    *       which are discarded because of a full receive buffer, with num = 1), and neither
+    *       Read() nor the receive interrupt releases a mailbox.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16S (*ReadN)(CPU_INT16S paraId, CPU_INT08U *buffer, CPU_INT16U size, CPU_INT16U num);
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  DRIVER RECEIVE INTERRUPT CONTROL FUNCTION
+    * \ingroup  UCCAN
+    *
+    *       This member holds the optional function pointer to a CAN lowlevel device driver
+    *       function, which disables (enable = 0) or enables (enable = 1) the receive interrupt
+    *       of the device. If NULL_PTR (or ReadN is NULL_PTR), the bus is never polled.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16S (*RxIrq)(CPU_INT16S paraId, CPU_INT08U enable);
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  DRIVER TRANSMIT READY FUNCTION
+    * \ingroup  UCCAN
+    *
+    *       This member holds the optional function pointer to a CAN lowlevel device driver
+    *       function, which returns 1 if the device can accept a frame for transmission, 0 if the
+    *       device is busy, or -1 on error. The function is called with disabled interrupts for
+    *       each transmitted frame and shall only read the device status. If NULL_PTR, the status
+    *       is requested with IoCtl() and the function code Io[CAN_TX_READY].
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16S (*TxReady)(CPU_INT16S paraId);
 
 } CANBUS_PARA;
 
 
+#if CANBUS_TX_CONFIRM_EN > 0
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      TRANSMIT CONFIRMATION FUNCTION
+* \ingroup  UCCAN
+*
+*           This function type is called for every frame, which is written with CanBusWriteAsync().
+*           The argument result is CAN_ERR_NONE, when the frame is sent to the bus, or
+*           CAN_ERR_TXABORT, when the frame is removed from the transmit queue or the device.
+*
+* \note     The function is called from CanBusTxHandler() or with disabled interrupts.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+typedef void (*CANBUS_TX_FUNC)(CPU_INT16S busId, void *arg, CPU_INT16S result);
+#endif
+
+
 /*-----------------------------------------------------------------------------------------------------*/
 /*!
 * \brief                      CAN BUS OBJECT
@@ -353,110 +635,1137 @@ typedef struct {
 	* \brief                      CAN BUS TRANSMIT FRAME BUFFER
 	* \ingroup  UCCAN
 	*
-	*           Allocation of transmit can bus frame buffer
+	*           Pointer to transmit can bus frame buffer. The buffer is used as a single
+	*           producer (CanBusWrite) / single consumer (CanBusTxHandler) ring buffer. With
+	*           CANBUS_TX_PRIO_EN, the buffer is a binary heap ordered by identifier priority.
+	*/
+	/*-------------------------------------------------------------------------------------------------*/
+	CANFRM    *BufTx;
+
+	/*-------------------------------------------------------------------------------------------------*/
+	/*!
+	* \brief                      CAN BUS TRANSMIT BUFFER INDEX MASK
+	* \ingroup  UCCAN
+	*
+	*           Number of entries in the transmit frame buffer minus 1.
 	*/
 	/*-------------------------------------------------------------------------------------------------*/
-	CANFRM     BufTx[CANBUS_TX_QSIZE];
+	CPU_INT16U TxMask;
 
 	/*-------------------------------------------------------------------------------------------------*/
 	/*!
 	* \brief                      CAN BUS TRANSMIT BUFFER READ FRAME
 	* \ingroup  UCCAN
 	*
-	*           Next read location in can bus frame buffer
+	*           Free running read counter. The next read location in the can bus frame buffer
+	*           is (BufTxRd & TxMask). Only the consumer writes this member.
 	*/
 	/*-------------------------------------------------------------------------------------------------*/
-	CPU_INT16U BufTxRd;
+	volatile CPU_INT16U BufTxRd;
 
 	/*-------------------------------------------------------------------------------------------------*/
 	/*!
 	* \brief                      CAN BUS TRANSMIT BUFFER WRITE FRAME
 	* \ingroup  UCCAN
 	*
-	*           Next write location in can bus frame buffer
+	*           Free running write counter. The next write location in the can bus frame buffer
+	*           is (BufTxWr & TxMask). Only the producer writes this member.
 	*/
 	/*-------------------------------------------------------------------------------------------------*/
-	CPU_INT16U BufTxWr;
+	volatile CPU_INT16U BufTxWr;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  CAN BUS TRANSMIT BUFFER RESERVED FRAMES
+    * \ingroup  UCCAN
+    *
+    *       Number of transmit buffer entries, which are handed out by CanBusTxReserve() and not
+    *       yet published with CanBusTxCommit(). These entries start at the write location.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U TxReserved;
+
+#if CANBUS_TX_PRIO_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  CAN BUS TRANSMIT BUFFER SEQUENCE NUMBERS
+    * \ingroup  UCCAN
+    *
+    *       The transmit frame buffer is ordered as a binary heap by the identifier priority.
+    *       This member points to the sequence numbers of the heap entries to keep the queueing
+    *       order for frames with equal identifiers.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U *BufTxSeq;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  CAN BUS TRANSMIT SEQUENCE COUNTER
+    * \ingroup  UCCAN
+    *
+    *       Sequence number of the next queued frame.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U TxSeq;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  CAN BUS TRANSMIT BUFFER RESERVATION START
+    * \ingroup  UCCAN
+    *
+    *       Location of the first entry, which is handed out by CanBusTxReserve().
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U TxResBase;
+#endif
+
+#if CANBUS_TX_CONFIRM_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMIT CONFIRMATION FUNCTIONS
+    * \ingroup  UCCAN
+    *
+    *       Confirmation functions of the frames, which are written with CanBusWriteAsync() and
+    *       not yet confirmed. An entry with NULL_PTR is unused. The queued frame refers to its
+    *       entry with the confirmation tag (entry + 1) in CANFRM.Spare[0].
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANBUS_TX_FUNC TxCbFunc[CANBUS_TX_CONFIRM_N];
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMIT CONFIRMATION ARGUMENTS
+    * \ingroup  UCCAN
+    *
+    *       User arguments, which are given to the corresponding confirmation functions.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    void *TxCbArg[CANBUS_TX_CONFIRM_N];
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMIT CONFIRMATION TAGS OF SENT FRAMES
+    * \ingroup  UCCAN
+    *
+    *       Ring buffer with the confirmation tag (0 = no confirmation) of the frame, which is
+    *       written to the device. While a frame waits for confirmation, no further frame is
+    *       written to the device. The next call of CanBusTxHandler() confirms the frame.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT08U TxSent[CANBUS_TX_CONFIRM_N];
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMIT CONFIRMATION READ COUNTER
+    * \ingroup  UCCAN
+    *
+    *       Free running read counter of the sent frame tags.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U TxSentRd;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMIT CONFIRMATION WRITE COUNTER
+    * \ingroup  UCCAN
+    *
+    *       Free running write counter of the sent frame tags.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U TxSentWr;
+#endif
 
 	/*-------------------------------------------------------------------------------------------------*/
 	/*!
 	* \brief                      CAN BUS RECEIVE FRAME BUFFER
 	* \ingroup  UCCAN
 	*
-	*           Allocation of receive can bus frame buffer
+	*           Pointer to receive can bus frame buffer. The buffer is used as a single
+	*           producer (CanBusRxHandler) / single consumer (CanBusRead) ring buffer.
+	*/
+	/*-------------------------------------------------------------------------------------------------*/
+	CANFRM    *BufRx;
+
+	/*-------------------------------------------------------------------------------------------------*/
+	/*!
+	* \brief                      CAN BUS RECEIVE BUFFER INDEX MASK
+	* \ingroup  UCCAN
+	*
+	*           Number of entries in the receive frame buffer minus 1.
 	*/
 	/*-------------------------------------------------------------------------------------------------*/
-	CANFRM     BufRx[CANBUS_RX_QSIZE];
+	CPU_INT16U RxMask;
 
 	/*-------------------------------------------------------------------------------------------------*/
 	/*!
 	* \brief                      CAN BUS RECEIVE BUFFER READ FRAME
 	* \ingroup  UCCAN
 	*
-	*           Next read location in can bus frame buffer
+	*           Free running read counter. The next read location in the can bus frame buffer
+	*           is (BufRxRd & RxMask). Only the consumer writes this member, except the overflow
+	*           policy CANBUS_RX_DROP_OLDEST or CANBUS_RX_EVICT_PRIO (see RxPolicy).
 	*/
 	/*-------------------------------------------------------------------------------------------------*/
-	CPU_INT16U BufRxRd;
+	volatile CPU_INT16U BufRxRd;
 
 	/*-------------------------------------------------------------------------------------------------*/
 	/*!
 	* \brief                      CAN BUS RECEIVE BUFFER WRITE FRAME
 	* \ingroup  UCCAN
 	*
-	*           Next write location in can bus frame buffer
+	*           Free running write counter. The next write location in the can bus frame buffer
+	*           is (BufRxWr & RxMask). Only the producer writes this member.
 	*/
 	/*-------------------------------------------------------------------------------------------------*/
-	CPU_INT16U BufRxWr;
-
-#if CANBUS_STAT_EN > 0
+	volatile CPU_INT16U BufRxWr;
     /*-------------------------------------------------------------------------------------------------*/
     /*!
-    * \brief                  RECEIVED FRAMES
+    * \brief                  CAN BUS RECEIVE BUFFER PEEKED FRAMES
     * \ingroup  UCCAN
     *
-    *       This member holds the counter, which will be incremented every received CAN frame.
+    *       Number of received frames, which are handed out by CanBusRxPeek() and not yet
+    *       released with CanBusRxCommit(). These frames start at the read location.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U RxPeek;
+
+#if CANBUS_RX_POLICY_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE OVERFLOW POLICY
+    * \ingroup  UCCAN
     *
-    * \note This counter is incremented, when the CanBusRead() function successfully gives the
-    *       CAN frame to the application layer.
+    *       This member holds the handling of received frames, which find the receive queue full.
+    *       With a policy other than CANBUS_RX_DROP_NEWEST, the producer removes queued frames.
+    *       Therefore the consumer releases the entries within critical sections.
     */
     /*-------------------------------------------------------------------------------------------------*/
-    CPU_INT16U RxOk;
+    CPU_INT08U RxPolicy;
+#endif
+
+#if CANBUS_RX_MSG_EN > 0
     /*-------------------------------------------------------------------------------------------------*/
     /*!
-    * \brief                  TRANSMITTED FRAMES
+    * \brief                  RECEIVE MESSAGE UNPACKING
     * \ingroup  UCCAN
     *
-    *       This member holds the counter, which will be incremented every transmitted CAN frame.
+    *       This member holds the flag, that received frames are unpacked into the CAN messages
+    *       by the receive handling (see CanMsgDispatch()).
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_BOOLEAN RxMsg;
+#endif
+
+#if CANBUS_RX_COALESCE_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE COALESCING FRAMES
+    * \ingroup  UCCAN
     *
-    * \note This counter is incremented, when the CAN transmit complete interrupt indicates,
-    *       that the CAN frame is sent to the bus.
+    *       This member holds the number of received frames, which wake up the reader with a single
+    *       signal (0 or 1: each frame is signalled).
     */
     /*-------------------------------------------------------------------------------------------------*/
-    CPU_INT16U TxOk;
+    CPU_INT16U RxCoalFrames;
     /*-------------------------------------------------------------------------------------------------*/
     /*!
-    * \brief                  LOST RECEIVE FRAMES
+    * \brief                  RECEIVE COALESCING TIME
     * \ingroup  UCCAN
     *
-    *       This member holds the counter, which will be incremented for every received CAN frame
-    *       which can not transfered to the application, due to a full receive queue.
+    *       This member holds the maximal time (see CANOS_GetTime()) between the first not signalled
+    *       frame and the signal to the reader.
     */
     /*-------------------------------------------------------------------------------------------------*/
-    CPU_INT16U RxLost;
+    CPU_INT32U RxCoalTime;
     /*-------------------------------------------------------------------------------------------------*/
     /*!
-    * \brief                  LOST RECEIVE FRAMES
+    * \brief                  RECEIVE UNSIGNALLED FRAMES
     * \ingroup  UCCAN
     *
-    *       This member holds the counter, which will be incremented for every transmission CAN
-    *       frame, which can not transfered to the transmit interrupt handler due to a full
-    *       transmission queue.
+    *       This member holds the number of published frames in the receive buffer, which are not
+    *       yet signalled to the reader.
     */
     /*-------------------------------------------------------------------------------------------------*/
-    CPU_INT16U TxLost;
+    CPU_INT16U RxUnposted;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE FIRST UNSIGNALLED FRAME TIME
+    * \ingroup  UCCAN
+    *
+    *       This member holds the time (see CANOS_GetTime()) of the first not signalled frame.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxFirst;
+#endif
+
+#if CANBUS_RX_POLL_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE POLLING ENTER THRESHOLD
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of received frames per polling period, which switches
+    *       the bus from the receive interrupt to polling (0: the bus is never polled).
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U RxPollOn;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE POLLING LEAVE THRESHOLD
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of received frames per polling period, below which the
+    *       bus switches back from polling to the receive interrupt.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U RxPollOff;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE POLLING PERIOD
+    * \ingroup  UCCAN
+    *
+    *       This member holds the period (see CANOS_GetTime()) for measuring the receive load.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxPollPeriod;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE POLLING PERIOD START
+    * \ingroup  UCCAN
+    *
+    *       This member holds the start time (see CANOS_GetTime()) of the current load period.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxPollTime;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE POLLING FRAME COUNTER
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of read frames within the current load period.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U RxPollCnt;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE POLLING MODE
+    * \ingroup  UCCAN
+    *
+    *       This member is CAN_TRUE, while the receive interrupt is disabled and the bus is read
+    *       by CanBusRxPoll().
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    volatile CPU_BOOLEAN RxPolling;
+#endif
+
+#if CANBUS_RX_DEFER_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE STAGING RING
+    * \ingroup  UCCAN
+    *
+    *       Raw received frames, which are moved by CanBusRxHandler() out of the device and not
+    *       yet processed by CanBusRxService(). The ring is a single producer (interrupt) / single
+    *       consumer (service task) ring buffer.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANFRM BufStage[CANBUS_RX_STAGE_SIZE];
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE STAGING READ COUNTER
+    * \ingroup  UCCAN
+    *
+    *       Free running read counter of the staging ring. Only the service task writes this member.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    volatile CPU_INT16U StageRd;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE STAGING WRITE COUNTER
+    * \ingroup  UCCAN
+    *
+    *       Free running write counter of the staging ring. Only the receive interrupt writes
+    *       this member.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    volatile CPU_INT16U StageWr;
+#endif
+
+#if CANBUS_FILTER_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  ACCEPTANCE FILTER STATE
+    * \ingroup  UCCAN
+    *
+    *       This member holds CAN_TRUE, if the software acceptance filter is enabled.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_BOOLEAN FilterOn;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  STANDARD IDENTIFIER FILTER
+    * \ingroup  UCCAN
+    *
+    *       This bitmap holds one bit for each standard identifier. A set bit accepts the frames
+    *       with this identifier.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U FilterStd[(CANFRM_STD_ID_MSK + 1u) / 32u];
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  EXTENDED IDENTIFIER FILTER
+    * \ingroup  UCCAN
+    *
+    *       This table holds the accepted extended identifiers in ascending order.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U FilterExt[CANBUS_FILTER_EXT_N];
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  NUMBER OF EXTENDED IDENTIFIERS
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of used entries in the extended identifier table.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U FilterExtNum;
+#endif
+
+#if CANBUS_SUB_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  NUMBER OF SUBSCRIBERS
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of receive subscribers of this bus.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U SubNum;
+#endif
+
+#if CANBUS_GW_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  NUMBER OF GATEWAY ROUTES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of gateway routes with this bus as source.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U RouteNum;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  GATEWAY TRANSMIT QUEUE
+    * \ingroup  UCCAN
+    *
+    *       Frames, which are forwarded by the gateway to this bus while the device is busy. The
+    *       queue is filled by the receive handlers of the source busses within critical sections
+    *       and is emptied by CanBusTxHandler() before the transmit buffer of the bus.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANFRM BufGw[CANBUS_GW_QSIZE];
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  GATEWAY TRANSMIT QUEUE READ COUNTER
+    * \ingroup  UCCAN
+    *
+    *       Free running read counter of the gateway transmit queue.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    volatile CPU_INT16U GwRd;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  GATEWAY TRANSMIT QUEUE WRITE COUNTER
+    * \ingroup  UCCAN
+    *
+    *       Free running write counter of the gateway transmit queue.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    volatile CPU_INT16U GwWr;
+#endif
+
+#if CANBUS_STAT_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVED FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the counter, which will be incremented every received CAN frame.
+    *
+    * \note This counter is incremented, when the CanBusRead() function successfully gives the
+    *       CAN frame to the application layer.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxOk;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMITTED FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the counter, which will be incremented every transmitted CAN frame.
+    *
+    * \note This counter is incremented, when the CAN frame is accepted by the device for the
+    *       transmission. A frame, which is rejected by the device, is dropped and counted in
+    *       TxErr instead. The transmit interrupt is not counted, because a single interrupt
+    *       may complete several frames.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U TxOk;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  LOST RECEIVE FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the counter, which will be incremented for every received CAN frame
+    *       which can not transfered to the application, due to a full receive queue.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxLost;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  LOST TRANSMIT FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the counter, which will be incremented for every transmission CAN
+    *       frame, which can not transfered to the transmit interrupt handler due to a full
+    *       transmission queue.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U TxLost;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE DRIVER ERRORS
+    * \ingroup  UCCAN
+    *
+    *       This member holds the counter, which will be incremented for every failed Read()
+    *       of the driver within the receive interrupt handler.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxErr;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMIT DRIVER ERRORS
+    * \ingroup  UCCAN
+    *
+    *       This member holds the counter, which will be incremented for every CAN frame, which
+    *       is not accepted by the Write() function of the driver.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U TxErr;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVED BITS
+    * \ingroup  UCCAN
+    *
+    *       This member holds the free running sum of bus bits of all received CAN frames
+    *       (worst case bit stuffing). Only the receive interrupt handler writes this member.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxBits;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMITTED BITS
+    * \ingroup  UCCAN
+    *
+    *       This member holds the free running sum of bus bits of all CAN frames, which are
+    *       accepted by the driver for transmission (worst case bit stuffing).
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U TxBits;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  BUS LOAD MEASUREMENT TIME
+    * \ingroup  UCCAN
+    *
+    *       This member holds the time (see CANOS_GetTime()) of the last statistic snapshot.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U LoadTime;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  BUS LOAD MEASUREMENT BITS
+    * \ingroup  UCCAN
+    *
+    *       This member holds the sum of received and transmitted bits at the last statistic
+    *       snapshot.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U LoadBits;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE QUEUE HIGH-WATER MARK
+    * \ingroup  UCCAN
+    *
+    *       This member holds the maximal number of frames in the receive queue.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U RxHwm;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMIT QUEUE HIGH-WATER MARK
+    * \ingroup  UCCAN
+    *
+    *       This member holds the maximal number of frames in the transmit queue.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U TxHwm;
+#if CANBUS_RX_POLICY_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  DROPPED NEWEST RECEIVE FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the counter, which will be incremented for every received CAN frame
+    *       which is lost with the policy CANBUS_RX_DROP_NEWEST, or which is lost itself, because
+    *       no queued frame can be removed with the active policy.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxDropNewest;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  DROPPED OLDEST RECEIVE FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the counter, which will be incremented for every CAN frame which
+    *       is lost with the policy CANBUS_RX_DROP_OLDEST.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxDropOldest;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  EVICTED RECEIVE FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the counter, which will be incremented for every CAN frame which
+    *       is lost with the policy CANBUS_RX_EVICT_PRIO.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxEvicted;
+#endif /* CANBUS_RX_POLICY_EN > 0 */
+#if CANBUS_RX_POLL_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE POLLING ENTER COUNTER
+    * \ingroup  UCCAN
+    *
+    *       This member holds the counter, which will be incremented for every switch from the
+    *       receive interrupt to polling.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxPollEnter;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE POLLING LEAVE COUNTER
+    * \ingroup  UCCAN
+    *
+    *       This member holds the counter, which will be incremented for every switch from
+    *       polling back to the receive interrupt.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxPollLeave;
+#endif /* CANBUS_RX_POLL_EN > 0 */
+#if CANBUS_GW_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  GATEWAY FORWARDED FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the counter, which will be incremented for every frame, which is
+    *       forwarded by the gateway to this bus.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U GwFwd;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  GATEWAY LOST FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the counter, which will be incremented for every frame, which is lost
+    *       for this bus due to a full gateway transmit queue.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U GwLost;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  GATEWAY DLC ERRORS
+    * \ingroup  UCCAN
+    *
+    *       This member holds the counter, which will be incremented for every received frame of
+    *       this bus, which matches a gateway route with a different data length code.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U GwDlcErr;
+#endif /* CANBUS_GW_EN > 0 */
+#endif /* CANBUS_STAT_EN > 0 */
+
+} CANBUS_DATA;
+
+
+#if CANBUS_STAT_EN > 0
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      CAN BUS STATISTICS
+* \ingroup  UCCAN
+*
+*           This structure holds a snapshot of the bus statistics, see CanBusIoCtl() with the
+*           function code CANBUS_GET_STAT.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVED FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of CAN frames, which are read by the application.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxOk;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMITTED FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of CAN frames, which are sent to the bus.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U TxOk;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  LOST RECEIVE FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of lost receive CAN frames.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxLost;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  LOST TRANSMIT FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of lost transmit CAN frames.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U TxLost;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE DRIVER ERRORS
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of failed Read() calls of the driver.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxErr;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMIT DRIVER ERRORS
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of failed Write() calls of the driver.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U TxErr;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE QUEUE HIGH-WATER MARK
+    * \ingroup  UCCAN
+    *
+    *       This member holds the maximal number of frames in the receive queue.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U RxHwm;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TRANSMIT QUEUE HIGH-WATER MARK
+    * \ingroup  UCCAN
+    *
+    *       This member holds the maximal number of frames in the transmit queue.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U TxHwm;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  BUS LOAD
+    * \ingroup  UCCAN
+    *
+    *       This member holds the bus load in percent since the previous snapshot. The load is
+    *       estimated with the frame length (worst case bit stuffing) of all received and
+    *       transmitted frames and the configured baudrate.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT08U Load;
+#if CANBUS_RX_POLICY_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  DROPPED NEWEST RECEIVE FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of received CAN frames, which are lost with the policy
+    *       CANBUS_RX_DROP_NEWEST, or which are lost themselves, because no queued frame can be
+    *       removed with the active policy.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxDropNewest;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  DROPPED OLDEST RECEIVE FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of CAN frames, which are lost with the policy
+    *       CANBUS_RX_DROP_OLDEST.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxDropOldest;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  EVICTED RECEIVE FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of CAN frames, which are lost with the policy
+    *       CANBUS_RX_EVICT_PRIO.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxEvicted;
+#endif
+#if CANBUS_RX_POLL_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE POLLING ENTER COUNTER
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of switches from the receive interrupt to polling.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxPollEnter;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE POLLING LEAVE COUNTER
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of switches from polling back to the receive interrupt.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RxPollLeave;
+#endif
+#if CANBUS_GW_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  GATEWAY FORWARDED FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of frames, which are forwarded by the gateway to this bus.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U GwFwd;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  GATEWAY LOST FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of frames, which are lost for this bus due to a full
+    *       gateway transmit queue.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U GwLost;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  GATEWAY DLC ERRORS
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of received frames of this bus, which are not forwarded
+    *       because of an unexpected data length code.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U GwDlcErr;
+#endif
+
+} CANBUS_STAT;
 #endif /* CANBUS_STAT_EN > 0 */
 
-} CANBUS_DATA;
+
+#if CANBUS_RX_COALESCE_EN > 0
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      CAN BUS RECEIVE COALESCING
+* \ingroup  UCCAN
+*
+*           This structure holds the coalescing settings of the receive signals, see CanBusIoCtl()
+*           with the function code CANBUS_SET_RX_COALESCE.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of received frames, which wake up the reader. The number
+    *       is limited to the receive queue size of the bus.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U Frames;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  TIME
+    * \ingroup  UCCAN
+    *
+    *       This member holds the maximal delay in microseconds between the first not signalled
+    *       frame and the wake up of the reader. The delay is rounded up to the resolution of
+    *       CANOS_GetTime() and is checked in CanBusRxHandler() and CanBusRxTimer().
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U Time;
+
+} CANBUS_COALESCE;
+#endif
+
+
+#if CANBUS_RX_POLL_EN > 0
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      CAN BUS RECEIVE POLLING
+* \ingroup  UCCAN
+*
+*           This structure holds the load thresholds for switching the reception between the
+*           receive interrupt and polling, see CanBusIoCtl() with the function code
+*           CANBUS_SET_RX_POLL. The load is the number of read frames within a period.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  ENTER THRESHOLD
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of frames per period, which disables the receive interrupt
+    *       and switches to polling (0: the bus is never polled).
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U Enter;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  LEAVE THRESHOLD
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of frames per period, below which the receive interrupt
+    *       is enabled again. The value shall be less than or equal to the enter threshold.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U Leave;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  PERIOD
+    * \ingroup  UCCAN
+    *
+    *       This member holds the period for measuring the load in units of CANOS_GetTime()
+    *       (0 is handled as 1).
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U Period;
+
+} CANBUS_POLL;
+#endif
+
+
+#if CANBUS_SUB_EN > 0
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      CAN BUS RECEIVE SUBSCRIBER
+* \ingroup  UCCAN
+*
+*           This structure holds the runtime data of a receive subscriber. A subscriber gets all
+*           received frames of a bus, which match its identifier and mask, in its own queue.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  BUS
+    * \ingroup  UCCAN
+    *
+    *       This member holds the bus identifier of the subscriber, or -1 if the entry is unused.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    volatile CPU_INT16S BusId;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  IDENTIFIER
+    * \ingroup  UCCAN
+    *
+    *       This member holds the identifier (including RTR and EXT flag) of the subscribed frames.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U Identifier;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  IDENTIFIER MASK
+    * \ingroup  UCCAN
+    *
+    *       This member holds the mask of the identifier bits, which must match. A received frame
+    *       matches, if ((frm->Identifier ^ Identifier) & Mask) is 0.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U Mask;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  FRAME BUFFER
+    * \ingroup  UCCAN
+    *
+    *       This member points to the frame buffer of the subscriber. The buffer is used as a single
+    *       producer (CanBusRxHandler) / single consumer (CanBusSubRead) ring buffer.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANFRM *Buf;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  FRAME BUFFER INDEX MASK
+    * \ingroup  UCCAN
+    *
+    *       Number of entries in the frame buffer minus 1.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT16U QMask;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  FRAME BUFFER READ COUNTER
+    * \ingroup  UCCAN
+    *
+    *       Free running read counter. Only the consumer writes this member.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    volatile CPU_INT16U Rd;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  FRAME BUFFER WRITE COUNTER
+    * \ingroup  UCCAN
+    *
+    *       Free running write counter. Only the producer writes this member.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    volatile CPU_INT16U Wr;
+#if CANBUS_STAT_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  LOST FRAMES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the number of frames, which are lost due to a full subscriber queue.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U Lost;
+#endif
+
+} CANBUS_SUB;
+#endif
+
+
+#if CANBUS_GW_EN > 0
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      CAN BUS GATEWAY ROUTE
+* \ingroup  UCCAN
+*
+*           This structure holds a routing rule of the gateway, see CanBusRouteAdd(). A received
+*           frame of the source bus, which matches the identifier and mask, is forwarded by the
+*           receive handler to all destination busses and is not stored in the receive queue.
+*
+* \note     For systems with very limited amount of RAM, this structure can be placed in
+*           ROM by declaring (and initializing) a const-variable during compile-time.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  IDENTIFIER
+    * \ingroup  UCCAN
+    *
+    *       This member holds the identifier (including RTR and EXT flag) of the routed frames.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U Identifier;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  IDENTIFIER MASK
+    * \ingroup  UCCAN
+    *
+    *       This member holds the mask of the identifier bits, which must match. A received frame
+    *       matches, if ((frm->Identifier ^ Identifier) & Mask) is 0.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U Mask;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  DESTINATION BUSSES
+    * \ingroup  UCCAN
+    *
+    *       This member holds the destination busses as bitmask (bit n = bus n).
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U DstMask;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  REWRITE IDENTIFIER
+    * \ingroup  UCCAN
+    *
+    *       This member holds the identifier bits, which replace the masked bits of the received
+    *       identifier (see RwMask).
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RwId;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  REWRITE MASK
+    * \ingroup  UCCAN
+    *
+    *       This member holds the mask of the identifier bits, which are replaced by RwId in the
+    *       forwarded frame (0: the identifier is forwarded unchanged).
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U RwMask;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  DATA LENGTH CODE
+    * \ingroup  UCCAN
+    *
+    *       This member holds the expected DLC of the routed frames. A matching frame with another
+    *       DLC is dropped. With CANBUS_GW_DLC_ANY, frames with any DLC are forwarded.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT08U DLC;
+
+} CANBUS_ROUTE;
+
+
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      CAN BUS GATEWAY ROUTE ENTRY
+* \ingroup  UCCAN
+*
+*           This structure holds the runtime data of a gateway route.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  BUS
+    * \ingroup  UCCAN
+    *
+    *       This member holds the source bus identifier of the route, or -1 if the entry is unused.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    volatile CPU_INT16S BusId;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  ROUTE
+    * \ingroup  UCCAN
+    *
+    *       This member points to the routing rule.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    const CANBUS_ROUTE *Route;
+
+} CANBUS_GW;
+#endif
 
 
 /*
@@ -475,10 +1784,69 @@ CPU_INT16S  CanBusRead     (CPU_INT16S    busId,
                             void         *buffer,
                             CPU_INT16U    size);
 
+CPU_INT16S  CanBusReadN    (CPU_INT16S    busId,
+                            CANFRM       *frames,
+                            CPU_INT16U    max,
+                            CPU_INT16U    timeout);
+
+CPU_INT16S  CanBusRxPeek   (CPU_INT16S     busId,
+                            const CANFRM **frames);
+
+CPU_INT16S  CanBusRxCommit (CPU_INT16S    busId,
+                            CPU_INT16U    num);
+
 CPU_INT16S  CanBusWrite    (CPU_INT16S    busId,
                             void         *buffer,
                             CPU_INT16U    size);
 
+CPU_INT16S  CanBusWriteN   (CPU_INT16S    busId,
+                            CANFRM       *frames,
+                            CPU_INT16U    num);
+
+#if CANBUS_TX_HANDLER_EN > 0
+CPU_INT16S  CanBusTxReserve(CPU_INT16S    busId,
+                            CANFRM      **frames,
+                            CPU_INT16U    max);
+
+CPU_INT16S  CanBusTxCommit (CPU_INT16S    busId,
+                            CPU_INT16U    num);
+#endif
+
+#if CANBUS_TX_CONFIRM_EN > 0
+CPU_INT16S  CanBusWriteAsync(CPU_INT16S      busId,
+                             void           *buffer,
+                             CPU_INT16U      size,
+                             CANBUS_TX_FUNC  func,
+                             void           *arg);
+#endif
+
+#if CANBUS_SUB_EN > 0
+CPU_INT16S  CanBusSubscribe(CPU_INT16S    busId,
+                            CPU_INT32U    identifier,
+                            CPU_INT32U    mask,
+                            CANFRM       *buf,
+                            CPU_INT16U    size);
+
+CPU_INT16S  CanBusUnsubscribe(CPU_INT16S  subId);
+
+CPU_INT16S  CanBusSubRead  (CPU_INT16S    subId,
+                            void         *buffer,
+                            CPU_INT16U    size,
+                            CPU_INT16U    timeout);
+#endif
+
+#if CANBUS_WAIT_EN > 0
+CPU_INT32U  CanBusWaitAny  (CPU_INT32U    busMask,
+                            CPU_INT16U    timeout);
+#endif
+
+#if CANBUS_GW_EN > 0
+CPU_INT16S  CanBusRouteAdd (CPU_INT16S           busId,
+                            const CANBUS_ROUTE  *route);
+
+CPU_INT16S  CanBusRouteDel (CPU_INT16S           routeId);
+#endif
+
 CPU_INT16S  CanBusEnable   (CANBUS_PARA  *cfg);
 
 CPU_INT16S  CanBusDisable  (CPU_INT16S    busId);
@@ -487,6 +1855,18 @@ void        CanBusTxHandler(CPU_INT16S    busId);
 
 void        CanBusRxHandler(CPU_INT16S    busId);
 
+#if CANBUS_RX_DEFER_EN > 0
+CPU_INT16S  CanBusRxService(CPU_INT16U    timeout);
+#endif
+
+#if CANBUS_RX_COALESCE_EN > 0
+void        CanBusRxTimer  (void);
+#endif
+
+#if CANBUS_RX_POLL_EN > 0
+CPU_INT16S  CanBusRxPoll   (void);
+#endif
+
 void        CanBusNSHandler(CPU_INT16S    busId);
 
 #if CANBUS_HOOK_NS_EN == 1
@@ -62,6 +62,9 @@ extern volatile CPU_INT16S can_errnum;
 #define CAN_ERR_SIGCREATE   -25
 #define CAN_ERR_FRMWIDTH    -26
 #define CAN_ERR_BUSINIT     -27
+#define CAN_ERR_SUBID       -28
+#define CAN_ERR_TXABORT     -29
+#define CAN_ERR_ROUTEID     -30
 #define CAN_ERR_OSINIT      -240
 #define CAN_ERR_OSFREE      -241
 #define CAN_ERR_OSQUEUE     -242
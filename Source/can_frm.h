@@ -40,6 +40,7 @@ extern "C" {
 */
 
 #include "cpu.h"                                      /* CPU configuration                             */
+#include "can_cfg.h"                                  /* CAN configuration                             */
 
 
 /*
@@ -83,6 +84,67 @@ extern "C" {
 #define CANFRM_LITTLE_ENDIAN  0x40u
 
 
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      IDENTIFIER: REMOTE TRANSMISSION REQUEST FLAG
+*
+*           This flag within the CAN identifier marks a remote transmission request.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+#define CANFRM_RTR_FLAG       0x40000000uL
+
+
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      IDENTIFIER: EXTENDED IDENTIFIER FLAG
+*
+*           This flag within the CAN identifier marks an extended identifier.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+#define CANFRM_EXT_FLAG       0x20000000uL
+
+
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      IDENTIFIER: STANDARD IDENTIFIER MASK
+*
+*           This mask holds the valid bits of a standard (11 bit) identifier.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+#define CANFRM_STD_ID_MSK     0x000007FFuL
+
+
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      IDENTIFIER: EXTENDED IDENTIFIER MASK
+*
+*           This mask holds the valid bits of an extended (29 bit) identifier.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+#define CANFRM_EXT_ID_MSK     0x1FFFFFFFuL
+
+
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      DRIVER FRAME SIZE
+*
+*           This define holds the number of bytes of a CAN frame, which are exchanged with the
+*           Read() and Write() functions of the CAN bus driver. Only with a hardware timestamp
+*           (CANFRM_TIMESTAMP_EN = 2) the timestamp is part of the driver frame.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+#if CANFRM_TIMESTAMP_EN == 1
+#define CANFRM_DRV_SIZE       ((CPU_INT16U)(sizeof(CANFRM) - sizeof(CPU_INT32U)))
+#else
+#define CANFRM_DRV_SIZE       ((CPU_INT16U)sizeof(CANFRM))
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                             DATA TYPES
@@ -134,9 +196,28 @@ typedef struct {
     * \brief                  SPARE
     *
     *       These bytes are added to get a frame size of an integral number of pointers.
+    *
+    * \note With CANBUS_TX_CONFIRM_EN the bus layer uses Spare[0] of queued transmit frames as
+    *       confirmation tag. The value of received frames and given transmit frames is ignored.
     */
     /*-------------------------------------------------------------------------------------------------*/
     CPU_INT08U Spare[3];
+#if CANFRM_TIMESTAMP_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  RECEIVE TIMESTAMP
+    *
+    *       This member holds the time of reception, captured in CanBusRxHandler(). With the
+    *       configuration CANFRM_TIMESTAMP_EN = 1 the value is taken from CANOS_GetTimestamp(),
+    *       with CANFRM_TIMESTAMP_EN = 2 the driver may overwrite it with the timestamp of the
+    *       CAN controller.
+    *
+    * \note The member is placed behind the frame data, which is exchanged with the drivers
+    *       (see CANFRM_DRV_SIZE), so drivers without a hardware timestamp are not affected.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U Timestamp;
+#endif
 
 } CANFRM;
 
@@ -33,7 +33,11 @@
 #include "can_msg.h"                                  /* CAN message handling functions                */
 #include "can_frm.h"                                  /* CAN frame handling functions                  */
 #include "can_sig.h"                                  /* CAN signal handling functions                 */
+#include "can_os.h"                                   /* CAN OS abstraction definitions                */
 #include "can_err.h"                                  /* CAN error codes                               */
+#if CANMSG_CHANGED_EN > 0
+#include "cpu_core.h"                                 /* CPU count trailing zeros                      */
+#endif
 
 
 /*
@@ -70,12 +74,560 @@ static CANMSG_DATA *CanMsgFreeLst;
 static CANMSG_DATA *CanMsgUsedLst;
 
 
+#if CANMSG_HASH_EN > 0
+/*
+*********************************************************************************************************
+*                                     IDENTIFIER HASH INDEX
+*
+* Open addressing hash table with linear probing. Each entry holds the message identifier of a used
+* CAN message, or -1 for an empty entry.
+*********************************************************************************************************
+*/
+
+static CPU_INT16S CanMsgHashTbl[CANMSG_HASH_SIZE];
+#endif
+
+
+#if (CANMSG_PLAN_EN > 0) || (CANMSG_CHANGED_EN > 0)
+/*
+*********************************************************************************************************
+*                                           CAN SIGNAL DATA
+*********************************************************************************************************
+*/
+
+extern CANSIG_DATA CanSigTbl[CANSIG_N];
+#endif
+
+
+#if (CANMSG_PLAN_EN > 0) && (CANMSG_LINK_EXT_EN > 0)
+/*
+*********************************************************************************************************
+*                                          PLAN ENTRY POOL
+*
+* The plan entries of a message are allocated as consecutive entries. An entry without a linked signal
+* is free.
+*********************************************************************************************************
+*/
+
+static CANMSG_PLAN CanMsgPlanPool[CANMSG_PLAN_N];
+#endif
+
+
+#if CANMSG_CHANGED_EN > 0
+/*
+*********************************************************************************************************
+*                                       CHANGED MESSAGE BITMAP
+*
+* A set bit marks a message with at least one linked signal changed since the last CanMsgRead().
+*********************************************************************************************************
+*/
+
+static CPU_INT32U CanMsgChgMap[CANMSG_MAP_N];
+
+
+/*
+*********************************************************************************************************
+*                                      SIGNAL BACK-REFERENCES
+*
+* For each signal, a set bit marks a message which links this signal.
+*********************************************************************************************************
+*/
+
+static CPU_INT32U CanMsgRefTbl[CANSIG_N][CANMSG_MAP_N];
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+#if CANMSG_HASH_EN > 0
+static  CPU_INT16U  CanMsgHash       (CPU_INT32U    identifier);
+
+static  void        CanMsgHashAdd    (CPU_INT16S    msgId);
+
+static  void        CanMsgHashRemove (CPU_INT16S    msgId);
+#endif
+
+#if CANMSG_PLAN_EN > 0
+static  void        CanMsgPlanCompile(CANMSG_DATA  *msg);
+
+#if CANMSG_LINK_EXT_EN > 0
+static  CANMSG_PLAN *CanMsgPlanFind  (CPU_INT08U    num);
+#endif
+#endif
+
+#if CANMSG_CHANGED_EN > 0
+static  void        CanMsgRefUpdate  (CANMSG_DATA  *msg,
+                                      CPU_BOOLEAN   add);
+#endif
+
+static  CPU_INT16S  CanMsgFind       (CPU_INT32U    identifier);
+
+static  void        CanMsgUnpack     (CANMSG_DATA  *msg,
+                                      CANFRM       *frm);
+
+
 /*
 *********************************************************************************************************
 *                                              FUNCTIONS
 *********************************************************************************************************
 */
 
+#if CANMSG_HASH_EN > 0
+/*
+*********************************************************************************************************
+*                                            CanMsgHash()
+*
+* Description : Calculates the home entry of a CAN identifier in the hash index.
+*
+* Argument(s) : identifier   The CAN identifier
+*
+* Return(s)   : Index of the home entry in the hash index.
+*
+* Note(s)     : Multiplicative hashing spreads consecutive identifiers over the hash index.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  CanMsgHash (CPU_INT32U  identifier)
+{
+    return ((CPU_INT16U)((identifier * 0x9E3779B1u) >> 16u) & (CANMSG_HASH_SIZE - 1u));
+}
+
+
+/*
+*********************************************************************************************************
+*                                           CanMsgHashAdd()
+*
+* Description : Inserts a created CAN message in the hash index.
+*
+* Argument(s) : msgId    Unique message identifier
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function must be called with disabled interrupts. A message with an identifier,
+*               which is already in the hash index, is placed in front of the existing message, so
+*               CanMsgOpen() finds the last created message like the search in the used list.
+*********************************************************************************************************
+*/
+
+static  void  CanMsgHashAdd (CPU_INT16S  msgId)
+{
+    CPU_INT32U  identifier;                           /* Local: CAN identifier of the message          */
+    CPU_INT16U  i;                                    /* Local: hash index entry                       */
+    CPU_INT16S  tmp;                                  /* Local: displaced message identifier           */
+
+
+    identifier = CanMsgTbl[msgId].Cfg->Identifier;
+    i          = CanMsgHash(identifier);
+    while (CanMsgHashTbl[i] >= 0) {                   /* search the next empty entry                   */
+        if (CanMsgTbl[CanMsgHashTbl[i]].Cfg->Identifier == identifier) {
+            tmp              = CanMsgHashTbl[i];      /* same identifier: new message goes in front    */
+            CanMsgHashTbl[i] = msgId;
+            msgId            = tmp;
+        }
+        i = (i + 1u) & (CANMSG_HASH_SIZE - 1u);
+    }
+    CanMsgHashTbl[i] = msgId;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CanMsgHashRemove()
+*
+* Description : Removes a CAN message from the hash index.
+*
+* Argument(s) : msgId    Unique message identifier
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function must be called with disabled interrupts, while the message configuration
+*               is still linked. The following entries of the probe sequence are moved back into the
+*               freed entry, so no deleted markers are needed.
+*********************************************************************************************************
+*/
+
+static  void  CanMsgHashRemove (CPU_INT16S  msgId)
+{
+    CPU_INT16U  i;                                    /* Local: freed hash index entry                 */
+    CPU_INT16U  j;                                    /* Local: checked hash index entry               */
+    CPU_INT16U  home;                                 /* Local: home entry of checked message          */
+
+
+    i = CanMsgHash(CanMsgTbl[msgId].Cfg->Identifier);
+    while (CanMsgHashTbl[i] != msgId) {               /* search the entry of the message               */
+        if (CanMsgHashTbl[i] < 0) {                   /* see, if message is not in the hash index      */
+            return;
+        }
+        i = (i + 1u) & (CANMSG_HASH_SIZE - 1u);
+    }
+    j = i;
+    for (;;) {
+        j = (j + 1u) & (CANMSG_HASH_SIZE - 1u);
+        if (CanMsgHashTbl[j] < 0) {                   /* see, if end of probe sequence is reached      */
+            break;
+        }
+        home = CanMsgHash(CanMsgTbl[CanMsgHashTbl[j]].Cfg->Identifier);
+        if (((CPU_INT16U)(j - home) & (CANMSG_HASH_SIZE - 1u)) >=
+            ((CPU_INT16U)(j - i)    & (CANMSG_HASH_SIZE - 1u))) {
+            CanMsgHashTbl[i] = CanMsgHashTbl[j];      /* entry is reachable from the freed entry: move */
+            i                = j;
+        }
+    }
+    CanMsgHashTbl[i] = -1;                            /* mark last moved entry empty                   */
+}
+#endif                                                /* CANMSG_HASH_EN > 0                            */
+
+
+#if CANMSG_PLAN_EN > 0
+/*
+*********************************************************************************************************
+*                                         CanMsgPlanCompile()
+*
+* Description : Calculates the pack/unpack plan of all linked signals of a CAN message out of the
+*               signal link positions and the configured signal widths.
+*
+* Argument(s) : msg      Pointer to CAN message
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) This function must be called with disabled interrupts.
+*
+*               (2) A signal, which doesn't fit into the payload, gets the length 0. This signal is
+*                   skipped while packing and unpacked as value 0, like CanFrmSet() and CanFrmGet()
+*                   handle positions out of range.
+*
+*               (3) A big endian position addresses the most significant bit of the signal. The
+*                   following bits are counted downwards within the byte and continue with bit 7 of
+*                   the next byte, so the least significant bit is found in the last touched byte.
+*********************************************************************************************************
+*/
+
+static  void  CanMsgPlanCompile (CANMSG_DATA  *msg)
+{
+    CANMSG_PARA  *cfg  = msg->Cfg;                    /* Local: Pointer to CAN message config          */
+    CANMSG_PLAN  *plan = &msg->Plan[0];               /* Local: Pointer to pack/unpack plan            */
+    const CANMSG_LINK *lnk = &cfg->SigLst[0];         /* Local: Pointer to CAN signal link             */
+    CPU_INT16U    width;                              /* Local: signal width in bits                   */
+    CPU_INT16U    pos;                                /* Local: bit position of first signal bit       */
+    CPU_INT16U    lsb;                                /* Local: bit position of signal LSB             */
+    CPU_INT08U    coding;                             /* Local: coding of payload bytes                */
+    CPU_INT08U    i;                                  /* Local: loop variable                          */
+
+
+    for (i=0u; i<cfg->SigNum; i++) {                  /* until last used signal link reached:          */
+        plan->Sig    = &CanSigTbl[lnk->Id];           /* link signal object directly                   */
+        plan->Mask   = 0u;                            /* default: signal out of payload                */
+        plan->Offset = 0u;
+        plan->Shift  = 0u;
+        plan->Len    = 0u;
+        plan->Step   = 1u;
+        coding       = (lnk->Pos & CANFRM_CODING_MSK);/* get the coding bits out of position           */
+        pos          = (lnk->Pos & (CPU_INT08U)(~CANFRM_CODING_MSK));
+        width        = 0u;
+        if (plan->Sig->Cfg != NULL_PTR) {             /* see, if signal is created                     */
+            width = plan->Sig->Cfg->Width;            /* get configured signal width                   */
+        }
+                                                      /*-----------------------------------------------*/
+#if CANSIG_GRANULARITY == CAN_CFG_BYTE                /* BYTE GRANULARITY                              */
+                                                      /*-----------------------------------------------*/
+        if (((width == 1u) || (width == 2u) || (width == 4u)) &&
+            ((pos + width) <= 8u)) {                  /* see, if width and position are in range       */
+            width = width * 8u;                       /* yes: convert to bit width and bit position    */
+            pos   = pos   * 8u;
+            if (coding == CANFRM_BIG_ENDIAN) {        /* big endian: position of MSB in first byte     */
+                pos += 7u;
+            }
+        } else {
+            width = 0u;                               /* otherwise: mark signal out of payload         */
+        }
+                                                      /*-----------------------------------------------*/
+#else                                                 /* BIT GRANULARITY                               */
+                                                      /*-----------------------------------------------*/
+        if ((width > 32u) || ((width + pos) > 64u)) { /* see, if width or position is out of range     */
+            width = 0u;                               /* yes: mark signal out of payload               */
+        }
+#endif
+                                                      /*-----------------------------------------------*/
+        if (width > 0u) {                             /* see, if signal is in payload                  */
+            if (coding == CANFRM_BIG_ENDIAN) {        /* big endian: count bits from end of payload    */
+                lsb = ((7u - (pos / 8u)) * 8u) + (pos % 8u) + 1u;
+                if (lsb >= width) {                   /* see, if LSB is within payload (see note 3)    */
+                    lsb          = lsb - width;
+                    plan->Offset = (CPU_INT08U)(7u - (lsb / 8u));
+                    plan->Step   = 0xFFu;             /* more significant bytes at lower index         */
+                } else {
+                    width        = 0u;                /* otherwise: mark signal out of payload         */
+                }
+            } else {                                  /* little endian: LSB at given position          */
+                lsb          = pos;
+                plan->Offset = (CPU_INT08U)(pos / 8u);
+            }
+        }
+        if (width > 0u) {                             /* see, if signal is still in payload            */
+            plan->Shift = (CPU_INT08U)(lsb % 8u);     /* set position of LSB in first byte             */
+            plan->Len   = (CPU_INT08U)((plan->Shift + width + 7u) / 8u);
+            if (width < 32u) {                        /* set mask with signal width                    */
+                plan->Mask = ((CPU_INT32U)1u << width) - 1u;
+            } else {
+                plan->Mask = 0xFFFFFFFFu;
+            }
+        }
+        plan++;                                       /*lint !e960 set pointer to next plan entry      */
+        lnk++;                                        /*lint !e960 set pointer to next signal link     */
+    }
+}
+#endif                                                /* CANMSG_PLAN_EN > 0                            */
+
+
+/*
+*********************************************************************************************************
+*                                          CanMsgPlanFind()
+*
+* Description : Searches the first free range of consecutive entries in the plan entry pool.
+*
+* Argument(s) : num      Number of needed plan entries
+*
+* Return(s)   : Pointer to the first plan entry of the range, or NULL_PTR if no range is free.
+*
+* Note(s)     : This function must be called with disabled interrupts. The entries are not reserved by
+*               this function; they are used as soon as CanMsgPlanCompile() links the signals.
+*********************************************************************************************************
+*/
+
+#if (CANMSG_PLAN_EN > 0) && (CANMSG_LINK_EXT_EN > 0)
+static  CANMSG_PLAN  *CanMsgPlanFind (CPU_INT08U  num)
+{
+    CPU_INT16U  i;                                    /* Local: loop through plan entry pool           */
+    CPU_INT16U  len = 0u;                             /* Local: length of current free range           */
+
+
+    if (num == 0u) {                                  /* see, if message has no linked signals         */
+        return (&CanMsgPlanPool[0]);                  /* yes: no entry is used                         */
+    }
+    for (i=0u; i<CANMSG_PLAN_N; i++) {                /* loop through plan entry pool                  */
+        if (CanMsgPlanPool[i].Sig == NULL_PTR) {      /* see, if entry is free                         */
+            len++;                                    /* yes: extend free range                        */
+            if (len == num) {                         /* see, if free range is large enough            */
+                return (&CanMsgPlanPool[i + 1u - len]);
+            }
+        } else {
+            len = 0u;                                 /* otherwise: start new free range               */
+        }
+    }
+    return (NULL_PTR);                                /* no free range found                           */
+}
+#endif                                                /* CANMSG_LINK_EXT_EN > 0                        */
+
+
+/*
+*********************************************************************************************************
+*                                          CanMsgRefUpdate()
+*
+* Description : Adds or removes the back-references from the linked signals to a CAN message.
+*
+* Argument(s) : msg      Pointer to CAN message
+*
+*               add      CAN_TRUE to add the references, CAN_FALSE to remove them
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) This function must be called with disabled interrupts.
+*
+*               (2) An added message is changed, if a linked signal is already changed. A removed
+*                   message is unchanged.
+*********************************************************************************************************
+*/
+
+#if CANMSG_CHANGED_EN > 0
+static  void  CanMsgRefUpdate (CANMSG_DATA  *msg,
+                               CPU_BOOLEAN   add)
+{
+    CANMSG_PARA   *cfg = msg->Cfg;                    /* Local: Pointer to CAN message config          */
+    const CANMSG_LINK *lnk;                           /* Local: Pointer to CAN signal link             */
+    CPU_INT16U     w;                                 /* Local: index of bitmap word                   */
+    CPU_INT32U     bit;                               /* Local: bit of message in bitmap word          */
+    CPU_INT32U     i;                                 /* Local: loop variable                          */
+
+
+    w    = (CPU_INT16U)(msg->Id >> 5u);               /* get bitmap position of message                */
+    bit  = (CPU_INT32U)1u << (msg->Id & 0x1Fu);
+    CanMsgChgMap[w] &= ~bit;                          /* clear changed flag of message                 */
+    lnk  = &cfg->SigLst[0];                           /* set can link pointer to first link            */
+    for (i=0u; i<cfg->SigNum; i++) {                  /* until last used signal link reached:          */
+        if (add == CAN_TRUE) {
+            CanMsgRefTbl[lnk->Id][w] |= bit;          /* reference message from signal                 */
+            if (CanSigTbl[lnk->Id].Status == CANSIG_CHANGED) {
+                CanMsgChgMap[w] |= bit;               /* see note (2)                                  */
+            }
+        } else {
+            CanMsgRefTbl[lnk->Id][w] &= ~bit;         /* remove reference from signal                  */
+        }
+        lnk++;                                        /*lint !e960 set pointer to next signal link     */
+    }
+}
+#endif                                                /* CANMSG_CHANGED_EN > 0                         */
+
+
+/*
+*********************************************************************************************************
+*                                            CanMsgFind()
+*
+* Description : Searches the last created CAN message with the given CAN identifier.
+*
+* Argument(s) : identifier    CAN identifier of the message
+*
+* Return(s)   : The message identifier, or CAN_ERR_NULLMSG if no message with this CAN identifier exists.
+*
+* Note(s)     : With CANMSG_HASH_EN, the message is searched in the identifier hash index instead of
+*               the used list.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16S  CanMsgFind (CPU_INT32U  identifier)
+{
+    CPU_INT16S    result = CAN_ERR_NULLMSG;           /* Local: Function result                        */
+#if CANMSG_HASH_EN > 0
+    CPU_INT16U    i;                                  /* Local: hash index entry                       */
+    CPU_INT16S    msgId;                              /* Local: message identifier in hash index       */
+#else
+    CANMSG_DATA  *msg;                                /* Local: Pointer to CAN message                 */
+#endif
+
+
+#if CANMSG_HASH_EN > 0
+    i     = CanMsgHash(identifier);                   /* get home entry of identifier                  */
+    msgId = CanMsgHashTbl[i];
+    while (msgId >= 0) {                              /* until identifier or empty entry is found      */
+        if (CanMsgTbl[msgId].Cfg->Identifier == identifier) { /* see, if identifier is equal           */
+            result = msgId;                           /* indicate, that configuration is found         */
+            break;
+        }
+        i     = (i + 1u) & (CANMSG_HASH_SIZE - 1u);   /* otherwise: check next entry                   */
+        msgId = CanMsgHashTbl[i];
+    }
+#else
+    msg = CanMsgUsedLst;                              /* set can message pointer                       */
+
+    while (msg != NULL_PTR) {                         /*   identifier is found or end reached          */
+        if (msg->Cfg->Identifier == identifier) {     /* see, if identifier is equal                   */
+            result = (CPU_INT16S)msg->Id;             /* indicate, that configuration is found         */
+            break;
+        }                                             /* otherwise, identifier is not correct          */
+        msg = msg->Next;                              /* set config pointer to next configuration      */
+    }
+#endif
+
+    return result;                                    /* Return function result                        */
+}
+
+
+/*
+*********************************************************************************************************
+*                                           CanMsgUnpack()
+*
+* Description : Destructs a CAN frame into the linked signals of a CAN message.
+*
+* Argument(s) : msg      Pointer to CAN message
+*
+*               frm      Pointer to CAN frame
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function must be called with disabled interrupts.
+*********************************************************************************************************
+*/
+
+static  void  CanMsgUnpack (CANMSG_DATA  *msg,
+                            CANFRM       *frm)
+{
+    CANSIG_VAL_T   value = 0u;                        /* Local: signal value (up to 32 bits)           */
+    CANMSG_PARA   *cfg   = msg->Cfg;                  /* Local: Pointer to CAN message config          */
+#if CANMSG_PLAN_EN > 0
+    CANMSG_PLAN   *plan;                              /* Local: Pointer to pack/unpack plan            */
+    CANSIG_DATA   *sig;                               /* Local: Pointer to CAN signal                  */
+    CPU_INT32U     val;                               /* Local: collected signal bits                  */
+    CPU_INT08U     sh;                                /* Local: number of collected signal bits        */
+    CPU_INT08U     idx;                               /* Local: index of payload byte                  */
+    CPU_INT08U     n;                                 /* Local: loop through payload bytes             */
+#else
+    CPU_INT16S     result;                            /* Local: function result (signal counter)       */
+    const CANMSG_LINK *lnk;                           /* Local: Pointer to CAN signal link             */
+    CPU_INT08U     width;                             /* Local: bit width of signal                    */
+#endif
+    CPU_INT32U     i;                                 /* Local: loop variable                          */
+
+
+#if CANMSG_PLAN_EN > 0
+    plan = &msg->Plan[0];                             /* set plan pointer to first linked signal       */
+    for (i=0u; i<cfg->SigNum; i++) {                  /* until last used signal link reached:          */
+        sig = plan->Sig;                              /* get linked signal                             */
+        val = 0u;                                     /* signal out of payload gets value 0            */
+        if (plan->Len > 0u) {                         /* see, if signal is in payload                  */
+            idx = plan->Offset;                       /* yes: get LSB part out of first byte           */
+            val = (CPU_INT32U)frm->Data[idx] >> plan->Shift;
+            sh  = (CPU_INT08U)(8u - plan->Shift);
+            for (n=1u; n<plan->Len; n++) {            /* collect remaining bytes                       */
+                idx  = (CPU_INT08U)(idx + plan->Step);/* set index to next more significant byte       */
+                val |= (CPU_INT32U)frm->Data[idx] << sh;
+                sh  += 8u;
+            }
+            val &= plan->Mask;                        /* remove bits of neighbour signals              */
+        }
+                                                      /*-----------------------------------------------*/
+        if ((sig->Status & CANSIG_PROT_RO) == 0u) {   /* check if write protection is enabled          */
+            value        = (CANSIG_VAL_T)val;
+            sig->Status &= CANSIG_CLR_STATUS;         /* clear status bits                             */
+            sig->Status |= CANSIG_UPDATED;            /* mark signal as updated                        */
+#if CANSIG_STATIC_CONFIG == 0
+            if ((sig->Status &                        /* check if timestamping is enabled              */
+                CANSIG_NO_TIMESTAMP) == 0) {
+                sig->TimeStamp = CANOS_GetTime();     /* set timestamp of signal                       */
+            }
+#endif
+            if (value != sig->Value) {                /* check, that signal value has changed          */
+#if CANSIG_CALLBACK_EN > 0
+                if (sig->Cfg->CallbackFct != NULL_PTR) {  /* see, if a callback function is defined    */
+                    sig->Cfg->CallbackFct((void*)sig, /* call the callback function                    */
+                                          &value,
+                                          CANSIG_CALLBACK_WRITE_ID);
+                }
+#endif                                                /* CANSIG_CALLBACK_EN > 0                        */
+                sig->Value   = value;                 /* store new value in signal                     */
+                sig->Status &= CANSIG_CLR_STATUS;     /* clear status bits                             */
+                sig->Status |= CANSIG_CHANGED;        /* mark signal as changed                        */
+#if CANMSG_CHANGED_EN > 0
+                CanMsgSigChanged((CPU_INT16S)(sig - &CanSigTbl[0])); /* mark linking messages changed  */
+#endif
+            }
+        }
+        plan++;                                       /*lint !e960 set pointer to next plan entry      */
+    }
+#else
+    lnk = &cfg->SigLst[0];                            /* set can link pointer to first link            */
+    for (i=0u; i<cfg->SigNum;i++) {                   /* until last used signal link reached:          */
+        result = CanSigIoCtl((CPU_INT16S)lnk->Id,     /* get configured signal width with              */
+                    (CPU_INT16U)CANSIG_GET_WIDTH,     /*   functioncode for getting width              */
+                    (void*)&width);                   /*   pointer to result variable                  */
+        CANSetErrRegister(result);
+
+        value = (CANSIG_VAL_T)CanFrmGet(frm,          /* get value out of CAN frame                    */
+                                        width,
+                                        lnk->Pos);    /*lint !e644 width is initialized                */
+        result = CanSigWrite((CPU_INT16S)lnk->Id,     /* write signal value with                       */
+                    (void *)&value,                   /*   pointer to value                            */
+                    CANSIG_MAX_WIDTH);                /*   with needed number of bytes                 */
+        CANSetErrRegister(result);
+
+        lnk++;                                        /*lint !e960 set pointer to next link            */
+    }
+#endif                                                /* CANMSG_PLAN_EN > 0                            */
+}
+
+
 /*
 *********************************************************************************************************
 *                                            CanMsgInit()
@@ -98,6 +650,9 @@ CPU_INT16S  CanMsgInit (CPU_INT32U  arg)
 {
     CANMSG_DATA  *msg = &CanMsgTbl[0];                /* Local: pointer to message                     */
     CPU_INT16U    i;                                  /* Local: loop variable                          */
+#if CANMSG_CHANGED_EN > 0
+    CPU_INT16U    w;                                  /* Local: loop through bitmap words              */
+#endif
 
 
     (void)arg;                                        /* unused; prevent compiler warning              */
@@ -118,6 +673,26 @@ CPU_INT16S  CanMsgInit (CPU_INT32U  arg)
 
     CanMsgFreeLst = CanMsgTbl;                        /* set free list pointer to complete list        */
     CanMsgUsedLst = NULL_PTR;                         /* set used list pointer to empty list           */
+#if CANMSG_HASH_EN > 0
+    for (i=0u; i<CANMSG_HASH_SIZE; i++) {             /* clear hash index                              */
+        CanMsgHashTbl[i] = -1;
+    }
+#endif
+#if (CANMSG_PLAN_EN > 0) && (CANMSG_LINK_EXT_EN > 0)
+    for (i=0u; i<CANMSG_PLAN_N; i++) {                /* mark all plan entries as free                 */
+        CanMsgPlanPool[i].Sig = NULL_PTR;
+    }
+#endif
+#if CANMSG_CHANGED_EN > 0
+    for (w=0u; w<CANMSG_MAP_N; w++) {                 /* clear changed message bitmap                  */
+        CanMsgChgMap[w] = 0u;
+    }
+    for (i=0u; i<CANSIG_N; i++) {                     /* clear all signal back-references              */
+        for (w=0u; w<CANMSG_MAP_N; w++) {
+            CanMsgRefTbl[i][w] = 0u;
+        }
+    }
+#endif
 
     return CAN_ERR_NONE;
 }
@@ -138,7 +713,8 @@ CPU_INT16S  CanMsgInit (CPU_INT32U  arg)
 *
 * Return(s)   : The message identifier for further access or -1 if an error occurs.
 *
-* Note(s)     : None.
+* Note(s)     : With CANMSG_HASH_EN, the message is searched in the identifier hash index instead of
+*               the used list.
 *********************************************************************************************************
 */
 
@@ -146,22 +722,13 @@ CPU_INT16S  CanMsgOpen (CPU_INT16S  drvId,
                         CPU_INT32U  devName,
                         CPU_INT16U  mode)
 {
-    CPU_INT16S    result = CAN_ERR_NULLMSG;           /* Local: Function result                        */
-    CANMSG_DATA  *msg;                                /* Local: Pointer to CAN message                 */
+    CPU_INT16S    result;                             /* Local: Function result                        */
 
 
     (void)drvId;                                      /* unused; prevent compiler warning              */
     (void)mode;                                       /* unused; prevent compiler warning              */
 
-    msg = CanMsgUsedLst;                              /* set can message pointer                       */
-
-    while (msg != NULL_PTR) {                         /*   identifier is found or end reached          */
-        if (msg->Cfg->Identifier == devName) {        /* see, if identifier is equal to devname        */
-            result = (CPU_INT16S)msg->Id;             /* indicate, that configuration is found         */
-            break;
-        }                                             /* otherwise, identifier is not correct          */
-        msg = msg->Next;                              /* set config pointer to next configuration      */
-    }
+    result = CanMsgFind(devName);                     /* search message with identifier                */
 
     CANSetErrRegister(result);
 
@@ -192,13 +759,15 @@ CPU_INT16S  CanMsgIoCtl (CPU_INT16S   msgId,
                          void        *argp)
 {
     CPU_INT16S    result = CAN_ERR_IOCTRLFUNC;        /* Local: Function result                        */
+#if CANMSG_CHANGED_EN == 0
     CANMSG_PARA  *cfg;                                /* Local: Pointer to CAN message config          */
     CANMSG_DATA  *msg;                                /* Local: Pointer to CAN message                 */
-    CANMSG_LINK  *lnk;                                /* Local: Pointer to CAN signal link             */
+    const CANMSG_LINK *lnk;                           /* Local: Pointer to CAN signal link             */
     CPU_INT08U    status;                             /* Local: Status of CAN signal                   */
     CPU_INT08U    len;                                /* Local: Number of linked signals               */
-    CPU_BOOLEAN   sumStatus;                          /* Local: Summarized CAN signal status           */
     CPU_INT32U    i;                                  /* Local: loop variable                          */
+#endif
+    CPU_BOOLEAN   sumStatus;                          /* Local: Summarized CAN signal status           */
 
 
 #if CANMSG_ARG_CHK_EN > 0
@@ -217,14 +786,22 @@ CPU_INT16S  CanMsgIoCtl (CPU_INT16S   msgId,
     }
 #endif                                                /* CANMSG_ARG_CHK_EN > 0                         */
 
+#if CANMSG_CHANGED_EN == 0
     msg = &CanMsgTbl[msgId];                          /* set can message pointer                       */
     cfg = msg->Cfg;                                   /* set can message config pointer                */
+#endif
 
     switch (func) {                                   /* Select function with functioncode             */
                                                       /*-----------------------------------------------*/
         case CANMSG_IS_CHANGED:                       /*               CHECK FOR CHANGE                */
                                                       /*-----------------------------------------------*/
             sumStatus = CAN_FALSE;                    /* reset flag to 'unchanged'                     */
+#if CANMSG_CHANGED_EN > 0
+            if ((CanMsgChgMap[(CPU_INT16U)msgId >> 5u] &  /* see, if changed flag of message is set    */
+                ((CPU_INT32U)1u << ((CPU_INT16U)msgId & 0x1Fu))) != 0u) {
+                sumStatus = CAN_TRUE;                 /* indicate, that message is changed             */
+            }
+#else
             status    =  CANSIG_UNUSED;               /* set status to unused                          */
             lnk       = &cfg->SigLst[0];              /* set can link pointer to first link            */
             len       =  cfg->SigNum;                 /* get length of link list                       */
@@ -240,6 +817,7 @@ CPU_INT16S  CanMsgIoCtl (CPU_INT16S   msgId,
                 }
                 lnk++;                                /*lint !e960 set pointer to next signal link     */
             }
+#endif                                                /* CANMSG_CHANGED_EN > 0                         */
             *((CPU_BOOLEAN *)argp) = sumStatus;       /* indicate, that message is changed             */
             result = CAN_ERR_NONE;                    /* okay, status calculated                       */
             break;
@@ -278,13 +856,22 @@ CPU_INT16S  CanMsgRead (CPU_INT16S   msgId,
                         void        *buffer,
                         CPU_INT16U   size)
 {
-    CPU_INT16S     result;                            /* Local: function result (signal counter)       */
     CANSIG_VAL_T   value = 0u;                        /* Local: signal value (up to 32 bits)           */
     CANFRM        *frm   = (CANFRM *)buffer;          /* Local: constructed CAN frame                  */
     CANMSG_PARA   *cfg;                               /* Local: Pointer to CAN message config          */
     CANMSG_DATA   *msg;                               /* Local: Pointer to CAN message                 */
-    CANMSG_LINK   *lnk;                               /* Local: Pointer to CAN signal link             */
+#if CANMSG_PLAN_EN > 0
+    CANMSG_PLAN   *plan;                              /* Local: Pointer to pack/unpack plan            */
+    CANSIG_DATA   *sig;                               /* Local: Pointer to CAN signal                  */
+    CPU_INT32U     val;                               /* Local: remaining signal bits                  */
+    CPU_INT32U     msk;                               /* Local: remaining signal mask bits             */
+    CPU_INT08U     idx;                               /* Local: index of payload byte                  */
+    CPU_INT08U     n;                                 /* Local: loop through payload bytes             */
+#else
+    CPU_INT16S     result;                            /* Local: function result (signal counter)       */
+    const CANMSG_LINK *lnk;                           /* Local: Pointer to CAN signal link             */
     CPU_INT08U     width = 0u;                        /* Local: bit width of signal                    */
+#endif
     CPU_INT32U     i;                                 /* Local: loop variable                          */
     CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
 
@@ -318,6 +905,39 @@ CPU_INT16S  CanMsgRead (CPU_INT16S   msgId,
         frm->Data[i] = 0u;
     }
                                                       /*-----------------------------------------------*/
+#if CANMSG_PLAN_EN > 0
+    plan = &msg->Plan[0];                             /* set plan pointer to first linked signal       */
+    for (i=0u; i<cfg->SigNum; i++) {                  /* until last used signal link reached:          */
+        sig = plan->Sig;                              /* get linked signal                             */
+#if CANSIG_CALLBACK_EN > 0
+        if (sig->Cfg->CallbackFct != NULL_PTR) {      /* see, if a callback function is defined        */
+            sig->Cfg->CallbackFct((void*)sig,         /* call the callback function                    */
+                                  NULL_PTR,
+                                  CANSIG_CALLBACK_READ_ID);
+        }
+#endif                                                /* CANSIG_CALLBACK_EN > 0                        */
+        value        = sig->Value;                    /* get signal value                              */
+        sig->Status &= CANSIG_CLR_STATUS;             /* clear status bits                             */
+        sig->Status |= CANSIG_UNCHANGED;              /* mark signal as 'unchanged'                    */
+                                                      /*-----------------------------------------------*/
+        if (plan->Len > 0u) {                         /* see, if signal is in payload                  */
+            val = (CPU_INT32U)value & plan->Mask;     /* yes: get signal bits and mask                 */
+            msk = plan->Mask;
+            idx = plan->Offset;                       /* insert LSB part in first byte                 */
+            frm->Data[idx] = (CPU_INT08U)((frm->Data[idx] & ~(msk << plan->Shift)) |
+                                          (val << plan->Shift));
+            val >>= (8u - plan->Shift);
+            msk >>= (8u - plan->Shift);
+            for (n=1u; n<plan->Len; n++) {            /* insert remaining bytes                        */
+                idx = (CPU_INT08U)(idx + plan->Step); /* set index to next more significant byte       */
+                frm->Data[idx] = (CPU_INT08U)((frm->Data[idx] & ~msk) | val);
+                val >>= 8u;
+                msk >>= 8u;
+            }
+        }
+        plan++;                                       /*lint !e960 set pointer to next plan entry      */
+    }
+#else
     lnk = &cfg->SigLst[0];                            /* set can link pointer to first link            */
     for (i=0u; i<cfg->SigNum; i++) {                  /* until last used signal link reached:          */
         result = CanSigIoCtl((CPU_INT16S)lnk->Id,     /* get configured signal width with              */
@@ -334,6 +954,11 @@ CPU_INT16S  CanMsgRead (CPU_INT16S   msgId,
         CanFrmSet(frm, value, width, lnk->Pos);
         lnk++;                                        /*lint !e960 set pointer to next signal link     */
     }
+#endif                                                /* CANMSG_PLAN_EN > 0                            */
+#if CANMSG_CHANGED_EN > 0
+    CanMsgChgMap[(CPU_INT16U)msgId >> 5u] &=          /* clear changed flag of message                 */
+        ~((CPU_INT32U)1u << ((CPU_INT16U)msgId & 0x1Fu));
+#endif
     CPU_CRITICAL_EXIT();                              /* enable interrupts                             */
                                                       /*-----------------------------------------------*/
     return ((CPU_INT16S)sizeof(CANFRM));              /* Return (number of bytes)                      */
@@ -362,14 +987,7 @@ CPU_INT16S  CanMsgWrite (CPU_INT16S   msgId,
                          void        *buffer,
                          CPU_INT16U   size)
 {
-    CANSIG_VAL_T   value = 0u;                        /* Local: signal value (up to 32 bits)           */
-    CPU_INT16S     result;                            /* Local: function result (signal counter)       */
     CANFRM        *frm   = (CANFRM *)buffer;          /* Local: constructed CAN frame                  */
-    CANMSG_PARA   *cfg;                               /* Local: Pointer to CAN message config          */
-    CANMSG_DATA   *msg;                               /* Local: Pointer to CAN message                 */
-    CANMSG_LINK   *lnk;                               /* Local: Pointer to CAN signal link             */
-    CPU_INT08U     width;                             /* Local: bit width of signal                    */
-    CPU_INT32U     i;                                 /* Local: loop variable                          */
 #if CPU_CFG_CRITICAL_METHOD == CPU_CRITICAL_METHOD_STATUS_LOCAL
     CPU_SR cpu_sr;                                    /* LocaL: Storage for CPU status register        */
 #endif
@@ -396,31 +1014,148 @@ CPU_INT16S  CanMsgWrite (CPU_INT16S   msgId,
 #endif                                                /* CANMSG_ARG_CHK_EN > 0                         */
 
     CPU_CRITICAL_ENTER();                             /* disable interrupts                            */
-    msg = &CanMsgTbl[msgId];                          /* set can message pointer                       */
-    cfg = msg->Cfg;                                   /* set can message config pointer                */
-    lnk = &cfg->SigLst[0];                            /* set can link pointer to first link            */
-    for (i=0u; i<cfg->SigNum;i++) {                   /* until last used signal link reached:          */
-        result = CanSigIoCtl((CPU_INT16S)lnk->Id,     /* get configured signal width with              */
-                    (CPU_INT16U)CANSIG_GET_WIDTH,     /*   functioncode for getting width              */
-                    (void*)&width);                   /*   pointer to result variable                  */
-        CANSetErrRegister(result);
+    CanMsgUnpack(&CanMsgTbl[msgId], frm);             /* destruct frame into the linked signals        */
+    CPU_CRITICAL_EXIT();                              /* enable interrupts                             */
+                                                      /*-----------------------------------------------*/
+    return ((CPU_INT16S)sizeof(CANFRM));              /* Return number of bytes                        */
+}
 
-        value = (CANSIG_VAL_T)CanFrmGet(frm,          /* get value out of CAN frame                    */
-                                        width,
-                                        lnk->Pos);    /*lint !e644 width is initialized                */
-        result = CanSigWrite((CPU_INT16S)lnk->Id,     /* write signal value with                       */
-                    (void *)&value,                   /*   pointer to value                            */
-                    CANSIG_MAX_WIDTH);                /*   with needed number of bytes                 */
-        CANSetErrRegister(result);
 
-        lnk++;                                        /*lint !e960 set pointer to next link            */
+/*
+*********************************************************************************************************
+*                                          CanMsgDispatch()
+*
+* Description : This function searches the CAN message with the identifier of a received CAN frame and
+*               destructs the frame into the linked signals of this message.
+*
+* Argument(s) : frm       Pointer to received CAN frame
+*
+* Return(s)   : The message identifier, CAN_ERR_NULLMSG if no message with the identifier of the frame
+*               exists, or CAN_ERR_FRMSIZE if the frame is shorter than the configured message DLC.
+*
+* Note(s)     : This function is called by the CAN bus receive handling (see CANBUS_RX_MSG_EN) and may
+*               be called from interrupt context. A frame without a message is no error, therefore the
+*               error register is not changed in this case. A short frame is not destructed, because
+*               signals behind the received data bytes would get undefined values; the receive
+*               handling stores it in the receive buffer instead.
+*********************************************************************************************************
+*/
+
+CPU_INT16S  CanMsgDispatch (CANFRM  *frm)
+{
+    CPU_INT16S  msgId;                                /* Local: message identifier                     */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+#if CANMSG_ARG_CHK_EN > 0
+    if (frm == NULL_PTR) {                            /* is frame an invalid pointer?                  */
+        can_errnum = CAN_ERR_NULLPTR;
+        return CAN_ERR_NULLPTR;
+    }
+#endif                                                /* CANMSG_ARG_CHK_EN > 0                         */
+
+    CPU_CRITICAL_ENTER();                             /* disable interrupts                            */
+    msgId = CanMsgFind(frm->Identifier);              /* search message with frame identifier          */
+    if (msgId >= 0) {                                 /* see, if message exists                        */
+        if (frm->DLC >= CanMsgTbl[msgId].Cfg->DLC) {  /* yes: see, if frame holds all message bytes    */
+            CanMsgUnpack(&CanMsgTbl[msgId], frm);     /* yes: destruct frame into the linked signals   */
+        } else {
+            msgId = CAN_ERR_FRMSIZE;                  /* no: frame is not consumed                     */
+        }
     }
     CPU_CRITICAL_EXIT();                              /* enable interrupts                             */
-                                                      /*-----------------------------------------------*/
-    return ((CPU_INT16S)sizeof(CANFRM));              /* Return number of bytes                        */
+
+    return (msgId);                                   /* return message identifier                     */
 }
 
 
+/*
+*********************************************************************************************************
+*                                         CanMsgNextChanged()
+*
+* Description : This function searches the changed message bitmap for the next changed CAN message,
+*               starting with the given message identifier.
+*
+* Argument(s) : msgId    Unique message identifier to start the search with
+*
+* Return(s)   : The identifier of the next changed message, or CAN_ERR_NULLMSG if no message with an
+*               identifier equal or greater than msgId is changed.
+*
+* Note(s)     : The changed flag of a message is cleared by CanMsgRead(). To send all changed messages,
+*               a task starts the search with 0 and continues with the found identifier + 1:
+*
+*                   msgId = CanMsgNextChanged(0);
+*                   while (msgId >= 0) {
+*                       CanMsgRead(msgId, &frm, sizeof(CANFRM));
+*                       ...
+*                       msgId = CanMsgNextChanged(msgId + 1);
+*                   }
+*********************************************************************************************************
+*/
+
+#if CANMSG_CHANGED_EN > 0
+CPU_INT16S  CanMsgNextChanged (CPU_INT16S  msgId)
+{
+    CPU_INT16S  result = CAN_ERR_NULLMSG;             /* Local: Function result                        */
+    CPU_INT32U  mask;                                 /* Local: mask for messages behind msgId         */
+    CPU_INT32U  bits;                                 /* Local: changed flags of a bitmap word         */
+    CPU_INT16U  w;                                    /* Local: index of bitmap word                   */
+    CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
+
+
+#if CANMSG_ARG_CHK_EN > 0
+    if (msgId < 0) {                                  /* is msgId out of range?                        */
+        can_errnum = CAN_ERR_MSGID;
+        return CAN_ERR_MSGID;
+    }
+#endif                                                /* CANMSG_ARG_CHK_EN > 0                         */
+
+    w    = (CPU_INT16U)msgId >> 5u;                   /* get bitmap word of msgId                      */
+    mask = (CPU_INT32U)0xFFFFFFFFu << ((CPU_INT16U)msgId & 0x1Fu);
+    while ((w < CANMSG_MAP_N) && (result < 0)) {      /* until a changed message is found:             */
+        CPU_CRITICAL_ENTER();                         /* disable interrupts                            */
+        bits = CanMsgChgMap[w] & mask;                /* get changed flags, ignore flags before msgId  */
+        CPU_CRITICAL_EXIT();                          /* enable interrupts                             */
+        if (bits != 0u) {                             /* see, if a message in this word is changed     */
+            result = (CPU_INT16S)((w << 5u) +         /* yes: return id of first changed message       */
+                     (CPU_INT16U)CPU_CntTrailZeros32(bits));
+        }
+        mask = 0xFFFFFFFFu;                           /* take all flags of the following words         */
+        w++;
+    }
+
+    return (result);                                  /* return function result                        */
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CanMsgSigChanged()
+*
+* Description : This function marks all CAN messages, which link the given signal, as changed.
+*
+* Argument(s) : sigId    Unique signal identifier
+*
+* Return(s)   : none.
+*
+* Note(s)     : This function is called by CanSigWrite() and the message unpacking, when the value of
+*               the signal is changed. It must be called with disabled interrupts.
+*********************************************************************************************************
+*/
+
+void  CanMsgSigChanged (CPU_INT16S  sigId)
+{
+    CPU_INT32U  *ref = &CanMsgRefTbl[sigId][0];       /* Local: back-references of signal              */
+    CPU_INT16U   w;                                   /* Local: loop through bitmap words              */
+
+
+    for (w=0u; w<CANMSG_MAP_N; w++) {                 /* mark all referencing messages as changed      */
+        CanMsgChgMap[w] |= ref[w];
+    }
+}
+#endif                                                /* CANMSG_CHANGED_EN > 0                         */
+
+
 /*
 *********************************************************************************************************
 *                                           CanMsgCreate()
@@ -432,7 +1167,9 @@ CPU_INT16S  CanMsgWrite (CPU_INT16S   msgId,
 *
 * Return(s)   : The message identifier or an errorcode: -1
 *
-* Note(s)     : None.
+* Note(s)     : If CANMSG_PLAN_EN is enabled, the linked signals are resolved into the pack/unpack plan
+*               of the message. The linked signals must not be deleted or reconfigured while the message
+*               is in use.
 *********************************************************************************************************
 */
 
@@ -453,6 +1190,13 @@ CPU_INT16S  CanMsgCreate (CANMSG_PARA  *cfg)
         can_errnum = CAN_ERR_NULLPTR;
         return (result);
     }
+#if CANMSG_LINK_EXT_EN > 0
+    if ((cfg->SigNum != 0u) &&                        /* is link table a valid pointer?                */
+        (cfg->SigLst == NULL_PTR)) {
+        can_errnum = CAN_ERR_NULLPTR;
+        return CAN_ERR_NULLPTR;
+    }
+#endif
     for (n=0u; n<cfg->SigNum; n++) {                  /* are all linked signals in use?                */
         sigId = cfg->SigLst[n].Id;
         result = CanSigIoCtl((CPU_INT16S)sigId,       /* get signal status                             */
@@ -472,12 +1216,29 @@ CPU_INT16S  CanMsgCreate (CANMSG_PARA  *cfg)
     CPU_CRITICAL_ENTER();                             /* disable interrupts                            */
     if (CanMsgFreeLst != 0) {                         /* see, if a free message is available           */
         msg           = CanMsgFreeLst;                /* yes: get first element from free list         */
+#if (CANMSG_PLAN_EN > 0) && (CANMSG_LINK_EXT_EN > 0)
+        msg->Plan     = CanMsgPlanFind(cfg->SigNum);  /* search free plan entries for all links        */
+        if (msg->Plan == NULL_PTR) {                  /* see, if plan entry pool is exhausted          */
+            CPU_CRITICAL_EXIT();                      /* enable interrupts                             */
+            can_errnum = CAN_ERR_MSGCREATE;
+            return CAN_ERR_MSGCREATE;
+        }
+#endif
         CanMsgFreeLst = msg->Next;                    /* set free list root to next element            */
 
         msg->Cfg      = cfg;                          /* link configuration to this element            */
+#if CANMSG_PLAN_EN > 0
+        CanMsgPlanCompile(msg);                       /* precompile pack/unpack plan of the signals    */
+#endif
+#if CANMSG_CHANGED_EN > 0
+        CanMsgRefUpdate(msg, CAN_TRUE);               /* reference message from the linked signals     */
+#endif
 
         msg->Next     = CanMsgUsedLst;                /* put element in front of used list             */
         CanMsgUsedLst = msg;                          /* set used list to new first element            */
+#if CANMSG_HASH_EN > 0
+        CanMsgHashAdd((CPU_INT16S)msg->Id);           /* insert element in identifier hash index       */
+#endif
 
         result = (CPU_INT16S)msg->Id;                 /* return id of created message                  */
     }
@@ -507,6 +1268,9 @@ CPU_INT16S  CanMsgDelete (CPU_INT16S  msgId)
 {
     CANMSG_DATA  *msg;                                /* Local: pointer to message data                */
     CANMSG_DATA  *previous;                           /* Local: pointer to previous used message       */
+#if (CANMSG_PLAN_EN > 0) && (CANMSG_LINK_EXT_EN > 0)
+    CPU_INT08U    n;                                  /* Local: loop through plan entries              */
+#endif
     CPU_SR_ALLOC();                                   /* LocaL: Storage for CPU status register        */
 
 
@@ -524,6 +1288,17 @@ CPU_INT16S  CanMsgDelete (CPU_INT16S  msgId)
 
     CPU_CRITICAL_ENTER();                             /* disable interrupts                            */
     msg = &CanMsgTbl[msgId];                          /* set pointer to message data                   */
+#if CANMSG_HASH_EN > 0
+    CanMsgHashRemove(msgId);                          /* remove message from identifier hash index     */
+#endif
+#if (CANMSG_PLAN_EN > 0) && (CANMSG_LINK_EXT_EN > 0)
+    for (n=0u; n<msg->Cfg->SigNum; n++) {             /* release plan entries of the message           */
+        msg->Plan[n].Sig = NULL_PTR;
+    }
+#endif
+#if CANMSG_CHANGED_EN > 0
+    CanMsgRefUpdate(msg, CAN_FALSE);                  /* remove references from the linked signals     */
+#endif
     msg->Cfg = NULL_PTR;                              /* mark message as 'unused'                      */
                                                       /*-----------------------------------------------*/
     if (CanMsgUsedLst == msg) {                       /* see, if message is root of used list          */
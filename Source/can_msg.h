@@ -40,6 +40,8 @@ extern "C" {
 
 #include "cpu.h"                                      /* CPU configuration                             */
 #include "can_cfg.h"                                  /* CAN abstraction module configuration          */
+#include "can_sig.h"                                  /* CAN signal data types                         */
+#include "can_frm.h"                                  /* CAN frame definitions                         */
 
 
 /*
@@ -106,12 +108,27 @@ extern "C" {
 /*!
 * \brief                      MAX NUMBER OF LINKS
 *
-*           This define holds the maximal number of linked signals per message.
+*           This define holds the maximal number of linked signals per message. With
+*           CANMSG_LINK_EXT_EN the links are placed in external arrays and the number of linked
+*           signals is not limited by this define.
 */
 /*-----------------------------------------------------------------------------------------------------*/
 
 #define CANMSG_MAX_LINK      8u
 
+#if CANMSG_CHANGED_EN > 0
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      CHANGED BITMAP SIZE
+*
+*           This define holds the number of 32bit words in a message bitmap. The message with the
+*           identifier msgId is represented by bit (msgId % 32) in word (msgId / 32).
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+#define CANMSG_MAP_N         ((CANMSG_N + 31u) / 32u)
+#endif
+
 /*-----------------------------------------------------------------------------------------------------*/
 /*!
 * \brief                      I/O CONTROL FUNCTIONCODES
@@ -128,6 +145,8 @@ enum CANMSG_IOCTL_FUNC {
     *       With this function code the IO control will check all linked signals for a change.
     *       If at least one signal is changed, the argument pointer will be used to set the
     *       boolen return status to TRUE, otherwise the return status will be set to FALSE.
+    *       With CANMSG_CHANGED_EN the changed flag of the message is returned instead. This
+    *       flag is set by every change of a linked signal and cleared by CanMsgRead().
     *
     * \note Argument pointer type: CPU_BOOLEAN *
     */
@@ -221,6 +240,18 @@ typedef struct {
      */
     /*-------------------------------------------------------------------------------------------------*/
     CPU_INT08U SigNum;
+#if CANMSG_LINK_EXT_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+     * \brief                 LINK TABLE
+     *
+     *      This member points to the first of the linked signals for this message. The links
+     *      are a slice of SigNum entries in a link array, which is usually shared by all
+     *      messages (see CanMsgLink[] in can_cfg.c).
+     */
+    /*-------------------------------------------------------------------------------------------------*/
+    const CANMSG_LINK *SigLst;
+#else
     /*-------------------------------------------------------------------------------------------------*/
     /*!
      * \brief                 LINK TABLE
@@ -229,10 +260,81 @@ typedef struct {
      */
     /*-------------------------------------------------------------------------------------------------*/
     CANMSG_LINK SigLst[CANMSG_MAX_LINK];
+#endif
 
 } CANMSG_PARA;
 
 
+#if CANMSG_PLAN_EN > 0
+/*-----------------------------------------------------------------------------------------------------*/
+/*!
+* \brief                      PACK/UNPACK PLAN
+*
+*           This structure holds the precompiled position of a linked signal within the CAN
+*           payload. The plan is calculated out of the signal link and the signal width once
+*           in CanMsgCreate(), so CanMsgRead() and CanMsgWrite() can copy the signal values
+*           without further function calls.
+*/
+/*-----------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  SIGNAL
+    *
+    *       This member holds the pointer to the linked signal object in the signal table.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CANSIG_DATA *Sig;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  MASK
+    *
+    *       This member holds the value mask with the signal width in bits.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT32U Mask;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  OFFSET
+    *
+    *       This member holds the index of the payload byte, which contains the least
+    *       significant bit of the signal.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT08U Offset;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  SHIFT
+    *
+    *       This member holds the bit position of the least significant signal bit within the
+    *       payload byte at the offset.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT08U Shift;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  LENGTH
+    *
+    *       This member holds the number of payload bytes, which are touched by the signal.
+    *       The length 0 marks a signal, which is out of the payload range.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT08U Len;
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+    * \brief                  STEP
+    *
+    *       This member holds the endianess as byte index increment towards the more significant
+    *       bytes: 1 for little endian and 0xFF (-1) for big endian.
+    */
+    /*-------------------------------------------------------------------------------------------------*/
+    CPU_INT08U Step;
+
+} CANMSG_PLAN;
+#endif
+
+
 /*-----------------------------------------------------------------------------------------------------*/
 /*!
 * \brief                      CAN MESSAGE OBJECT
@@ -259,6 +361,21 @@ typedef struct
      */
     /*-------------------------------------------------------------------------------------------------*/
     CANMSG_PARA *Cfg;
+#if CANMSG_PLAN_EN > 0
+    /*-------------------------------------------------------------------------------------------------*/
+    /*!
+     * \brief                 PACK/UNPACK PLAN
+     *
+     *      This array holds the precompiled plan for each linked signal. With CANMSG_LINK_EXT_EN
+     *      this member points to SigNum consecutive entries in the plan pool.
+     */
+    /*-------------------------------------------------------------------------------------------------*/
+#if CANMSG_LINK_EXT_EN > 0
+    CANMSG_PLAN *Plan;
+#else
+    CANMSG_PLAN Plan[CANMSG_MAX_LINK];
+#endif
+#endif
     /*-------------------------------------------------------------------------------------------------*/
     /*!
      * \brief                 MESSAGE LIST LINK
@@ -296,6 +413,14 @@ CPU_INT16S  CanMsgWrite (CPU_INT16S    msgId,
                          void         *buffer,
                          CPU_INT16U    size);
 
+CPU_INT16S  CanMsgDispatch(CANFRM       *frm);
+
+#if CANMSG_CHANGED_EN > 0
+CPU_INT16S  CanMsgNextChanged(CPU_INT16S  msgId);
+
+void        CanMsgSigChanged (CPU_INT16S  sigId);
+#endif
+
 CPU_INT16S  CanMsgCreate(CANMSG_PARA  *cfg);
 
 CPU_INT16S  CanMsgDelete(CPU_INT16S    msgId);
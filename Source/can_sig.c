@@ -33,6 +33,9 @@
 #include "can_sig.h"                                  /* CAN signal handling functions                 */
 #include "can_os.h"                                   /* CAN OS abstraction definitions                */
 #include "can_err.h"
+#if CANMSG_CHANGED_EN > 0
+#include "can_msg.h"                                  /* CAN message changed flags                     */
+#endif
 
 
 /*
@@ -366,6 +369,9 @@ CPU_INT16S  CanSigWrite (CPU_INT16S   sigId,
             sig->Value  = value;
             sig->Status &= CANSIG_CLR_STATUS;         /* clear status bits                             */
             sig->Status |= CANSIG_CHANGED;            /* mark signal as changed                        */
+#if CANMSG_CHANGED_EN > 0
+            CanMsgSigChanged(sigId);                  /* mark all linking messages as changed          */
+#endif
         }                                             /*-----------------------------------------------*/
     }
     CPU_CRITICAL_EXIT();                              /* allow interrupts                              */